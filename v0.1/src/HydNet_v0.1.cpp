@@ -9,12 +9,22 @@
 //	Headers
 
 #include<iostream>
+#include<fstream>
 #include<stdexcept>
+#include<climits>
 
 #include"Network.h"
 #include"LoopDepot.h"
 #include"steadyState.h"
 #include"transientState.h"
+#include"ensemble.h"
+#include"batch.h"
+#include"extendedPeriod.h"
+#include"criticality.h"
+#include"fireflow.h"
+#include"calibration.h"
+#include"rigidColumn.h"
+#include"Profile.h"
 using namespace std;
 
 //=============================================================================
@@ -28,14 +38,73 @@ try {
 	// build network from input
 	Network net {};
 
+	// count from here on
+	if (net.settings.profile)
+		Profile::enable();
+	if (net.settings.trace)
+		Profile::enableTrace(net.settings.traceInterval);
+
 	// generate loops
 	LoopDepot depot {net};
 
-	// compute steady state
-	Steady::compute(net, depot);
+	// log convergence if asked
+	ofstream convergence;
+
+	if (net.settings.convergence) {
+		convergence.open("convergence.csv");
+		if (!convergence)
+			throw runtime_error("main(): convergence.csv");
+	}
+
+	// compute steady state on all threads, every
+	//  mode starts from it
+	Steady::Status status {Steady::compute(net, depot,
+			Ensemble::threadCount(net.settings, INT_MAX),
+			net.settings.convergence ? &convergence : NULL)};
 
+	if (!status.converged)
+		throw runtime_error("Steady::compute(): not converged after "
+				+to_string(status.iterations)+" iterations, residual "
+				+to_string(status.residual)+" m");
+
+	// map steady state onto input network
+	if (net.skeleton.isReduced()) {
+		net.skeleton.expand(net);
+		net.skeleton.write();
+	}
+
+	// run scenarios
+	if (net.settings.mode == "ensemble") {
+		Ensemble::compute(net, depot);
+	}
+	// solve steady scenarios
+	else if (net.settings.mode == "batch") {
+		Batch::compute(net, depot);
+	}
+	// extended period simulation
+	else if (net.settings.mode == "period") {
+		Extended::compute(net, depot);
+	}
+	// close each element in turn
+	else if (net.settings.mode == "criticality") {
+		Criticality::compute(net, depot);
+	}
+	// draw fire flow at each hydrant
+	else if (net.settings.mode == "fireflow") {
+		FireFlow::compute(net, depot);
+	}
+	// fit parameters to observations
+	else if (net.settings.mode == "calibration") {
+		Calibration::compute(net, depot);
+	}
+	// integrate an incompressible network
+	else if (net.settings.mode == "rigid") {
+		Rigid::compute(net, depot);
+	}
 	// compute transient state
-	Transient::compute(net);
+	else {
+		Transient::compute(net);
+	}
 
 	// list network
 	net.log(cout);
@@ -43,6 +112,14 @@ try {
 
 	// list loops
 	depot.log(cout);
+
+	// report profile
+	if (net.settings.profile) {
+		Profile::log(cout);
+		Profile::report("profile.json");
+	}
+	if (net.settings.trace)
+		Profile::writeTrace("trace.json");
 }
 catch (ios_base::failure& e) {
 	cerr << "ios_base::failure: error: " << e.what() << '\n';
@@ -0,0 +1,104 @@
+// Definitions for Arena class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<cstddef>
+#include<cstdint>
+#include<new>
+#include<vector>
+#include<algorithm>
+
+#include"Arena.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Arena
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+Arena::Arena()
+	:Arena(65536) {}
+
+Arena::Arena(const size_t& size)
+	:blockSize{size}, blocks{}, cursor{NULL}, limit{NULL}, bytes{0},
+	objects{} {}
+
+Arena::~Arena()
+{
+	this->release();
+}
+
+//	Accessors =============================================================
+size_t Arena::getBytes() const
+{
+	return bytes;
+}
+
+size_t Arena::getObjects() const
+{
+	return objects.size();
+}
+
+//	Utility ===============================================================
+void Arena::release()
+{
+	// destroy in reverse order of construction
+	for (auto i = objects.rbegin(); i != objects.rend(); i++) {
+		i->second(i->first);
+	}
+	objects.clear();
+
+	// free blocks
+	for (char* b : blocks) {
+		::operator delete(b);
+	}
+	blocks.clear();
+
+	cursor = NULL;
+	limit = NULL;
+	bytes = 0;
+}
+
+//=============================================================================
+//	Private
+
+//	Allocation ============================================================
+void* Arena::reserve(const size_t& size, const size_t& align)
+{
+	// align cursor
+	uintptr_t p {reinterpret_cast<uintptr_t> (cursor)};
+	p = (p + align - 1) & ~(uintptr_t(align) - 1);
+
+	// open a new block, oversized requests get their own
+	if (cursor == NULL || p + size > reinterpret_cast<uintptr_t> (limit)) {
+		size_t s {max(blockSize, size + align)};
+
+		blocks.push_back(static_cast<char*> (::operator new(s)));
+		bytes += s;
+		Profile::count(Profile::ARENA_BYTES, s);
+
+		cursor = blocks.back();
+		limit = cursor + s;
+
+		p = reinterpret_cast<uintptr_t> (cursor);
+		p = (p + align - 1) & ~(uintptr_t(align) - 1);
+	}
+
+	cursor = reinterpret_cast<char*> (p + size);
+
+	return reinterpret_cast<void*> (p);
+}
@@ -0,0 +1,118 @@
+// Declarations for Arena class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Arena.cpp
+
+#ifndef ARENA_H
+#define ARENA_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<cstddef>
+#include<new>
+#include<utility>
+#include<vector>
+
+//=============================================================================
+//
+//	Arena
+
+/* block allocator for objects sharing a lifetime
+ * - objects are constructed in large blocks instead
+ *   of one heap allocation each
+ * - objects are never freed one by one, release()
+ *   destroys all of them in reverse order of
+ *   construction and frees the blocks in bulk
+ * - pointer arrays are not destroyed, they must
+ *   only hold pointers
+*/
+class Arena {
+public:
+	// constructors
+	Arena();
+	Arena(const std::size_t&);
+		// set block size [B]
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator= (const Arena&) = delete;
+
+	// accessors
+	std::size_t getBytes() const;
+		// get bytes reserved in blocks
+	std::size_t getObjects() const;
+		// get number of live objects
+
+	// construction
+	template<class Type, class... Args>
+	Type* make(Args&&...);
+		// construct an object in arena
+	template<class Type>
+	Type** makeArray(const int&);
+		// construct an array of NULL pointers
+
+	// utility
+	void release();
+		// destroy objects and free blocks
+
+private:
+	std::size_t blockSize;
+		// size of a regular block
+	std::vector<char*> blocks;
+		// reserved blocks
+	char* cursor;
+		// first free byte in last block
+	char* limit;
+		// end of last block
+	std::size_t bytes;
+		// bytes reserved in blocks
+	std::vector<std::pair<void*, void (*)(void*)>> objects;
+		// constructed objects and their destructors
+
+	// allocation
+	void* reserve(const std::size_t&, const std::size_t&);
+		// reserve aligned space
+
+	template<class Type>
+	static void destroy(void*);
+		// call destructor of an object
+};
+
+//	Templates =============================================================
+
+template<class Type, class... Args>
+Type* Arena::make(Args&&... args)
+{
+	void* p {this->reserve(sizeof(Type), alignof(Type))};
+	Type* t {new (p) Type (std::forward<Args>(args)...)};
+
+	objects.push_back(std::make_pair(p, &Arena::destroy<Type>));
+
+	return t;
+}
+
+template<class Type>
+Type** Arena::makeArray(const int& size)
+{
+	Type** array {static_cast<Type**> (this->reserve(size * sizeof(Type*),
+										alignof(Type*)))};
+
+	for (int i {0}; i < size; i++)
+		array[i] = NULL;
+
+	return array;
+}
+
+template<class Type>
+void Arena::destroy(void* p)
+{
+	static_cast<Type*> (p)->~Type();
+}
+
+#endif
@@ -6,7 +6,7 @@
 // tested:	14-9-2018
 // status:
 //
-// last edit: 	14-9-2018
+// last edit: 	18-10-2026
 
 //=============================================================================
 //	
@@ -33,7 +33,13 @@ using namespace std;
 Settings::Settings()
 	:fluid{}, gasFraction{1e-7}, discretization{1},
 	time{0}, timeStep{0}, symTime{0}, writeInterval{1},
-	weightingFactor{1}, referentPressure{1e5},
+	weightingFactor{1}, output{"csv"}, mode{"transient"}, threads{0}, profile{false},
+	trace{false}, traceInterval{100},
+	celerity{0}, ordering{"input"}, skeleton{false}, collapse{1e-3},
+	calibrate{"roughness"},
+	flowTolerance{1e-12}, headTolerance{1e-10}, convergence{false},
+	multirate{false}, lumped{0}, rigidStep{1},
+	referentPressure{1e5},
 	laminarCoeff{}, turbulentCoeff{} {}
 
 Settings::~Settings()
@@ -59,6 +65,28 @@ bool Settings::isValid()
 	else if (!fluid.isValid()) {
 		valid = false;
 	}
+	else if (output != "csv" && output != "compressed") {
+		valid = false;
+	}
+	else if (mode != "transient" && mode != "ensemble"
+		  && mode != "batch" && mode != "period"
+		  && mode != "criticality" && mode != "fireflow"
+		  && mode != "calibration" && mode != "rigid") {
+		valid = false;
+	}
+	else if (threads < 0 || celerity < 0 || traceInterval < 1) {
+		valid = false;
+	}
+	else if (ordering != "input" && ordering != "rcm") {
+		valid = false;
+	}
+	else if (collapse < 0 || lumped < 0 || rigidStep <= 0) {
+		valid = false;
+	}
+	else if (calibrate != "roughness" && calibrate != "demand"
+		  && calibrate != "all") {
+		valid = false;
+	}
 
 	return valid;
 
@@ -109,6 +137,67 @@ void handleInput(const string& tag, const string& num, Settings& settings)
 	else if (tag == "weightingfactor") {
 		settings.weightingFactor = stod(num);
 	}
+	else if (tag == "output") {
+		settings.output = num;
+	}
+	else if (tag == "mode") {
+		settings.mode = num;
+	}
+	else if (tag == "threads") {
+		settings.threads = stoi(num);
+	}
+	else if (tag == "profile") {
+		if (num != "on" && num != "off")
+			throw runtime_error("Settings::handleInput(): profile");
+		settings.profile = num == "on";
+	}
+	else if (tag == "trace") {
+		if (num != "on" && num != "off")
+			throw runtime_error("Settings::handleInput(): trace");
+		settings.trace = num == "on";
+	}
+	else if (tag == "traceinterval") {
+		settings.traceInterval = stoi(num);
+	}
+	else if (tag == "celerity") {
+		settings.celerity = stod(num);
+	}
+	else if (tag == "ordering") {
+		settings.ordering = num;
+	}
+	else if (tag == "skeleton") {
+		if (num != "on" && num != "off")
+			throw runtime_error("Settings::handleInput(): skeleton");
+		settings.skeleton = num == "on";
+	}
+	else if (tag == "collapse") {
+		settings.collapse = stod(num);
+	}
+	else if (tag == "calibrate") {
+		settings.calibrate = num;
+	}
+	else if (tag == "flowtolerance") {
+		settings.flowTolerance = stod(num);
+	}
+	else if (tag == "headtolerance") {
+		settings.headTolerance = stod(num);
+	}
+	else if (tag == "convergence") {
+		if (num != "on" && num != "off")
+			throw runtime_error("Settings::handleInput(): convergence");
+		settings.convergence = num == "on";
+	}
+	else if (tag == "multirate") {
+		if (num != "on" && num != "off")
+			throw runtime_error("Settings::handleInput(): multirate");
+		settings.multirate = num == "on";
+	}
+	else if (tag == "lumped") {
+		settings.lumped = stod(num);
+	}
+	else if (tag == "rigidstep") {
+		settings.rigidStep = stod(num);
+	}
 	else {
 		throw runtime_error("Settings::handleInput(): invalid");
 	}
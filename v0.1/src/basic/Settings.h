@@ -3,7 +3,7 @@
 // created:	14-9-2018
 // version:	0.3
 //
-// last edit: 	12-9-2018
+// last edit: 	18-10-2026
 //
 // definitions in: Settings.cpp
 
@@ -43,6 +43,77 @@ struct Settings {
 		// frequency of output
 	double weightingFactor;
 		// weighting factor in gas volume continuity equation
+	std::string output;
+		// output format
+		// - csv: plain text
+		// - compressed: lossless binary, see Codec.h
+	std::string mode;
+		// computation mode
+		// - transient: steady state followed by
+		//   a transient simulation
+		// - ensemble: transient simulation for each
+		//   entry of the 'scenarios' input file
+		// - batch: steady state for each entry
+		//   of the 'scenarios' input file
+		// - period: sequence of steady states
+		//   following the 'pattern' input file
+		// - criticality: steady state with each
+		//   element closed in turn
+		// - fireflow: steady state with a fire flow
+		//   drawn at each entry of the 'hydrants'
+		//   input file
+		// - calibration: fit parameters to the
+		//   'observations' input file
+		// - rigid: steady state followed by a rigid
+		//   column simulation, see rigidColumn.h
+	int threads;
+		// number of worker threads
+		//  0 to use all hardware threads
+	bool profile;
+		// write profile.json at exit
+	bool trace;
+		// write trace.json at exit
+	int traceInterval;
+		// trace every n-th time step
+	double celerity;
+		// pressure wave celerity override
+		//  0 to compute from element data
+	std::string ordering;
+		// internal numbering of nodes and elements
+		// - input: ids as read
+		// - rcm: reverse Cuthill-McKee, output
+		//   still uses input ids
+	bool skeleton;
+		// reduce network before solving,
+		//  see Network::skeletonize()
+	double collapse;					// [m]
+		// elements shorter than this are
+		//  collapsed into a node when the
+		//  network is reduced
+	std::string calibrate;
+		// parameters fitted in calibration mode
+		// - roughness: roughness of elements
+		// - demand: discharges of sources with demand
+		// - all: both
+	double flowTolerance;				// [m3s-1]
+		// Hardy-Cross converges when the largest
+		//  loop flow correction is below this
+	double headTolerance;				// [m]
+		// or when the largest loop head loss
+		//  residual is below this
+	bool convergence;
+		// write convergence.csv with every
+		//  Hardy-Cross iteration
+	bool multirate;
+		// step elements in power of two
+		//  multiples of the time step, by
+		//  their own Courant limit
+	double lumped;						// [m]
+		// elements shorter than this are solved
+		//  as lumped inertances and compliances
+		//  at their junctions, 0 meshes all
+	double rigidStep;					// [s]
+		// time step of the rigid column model
 	
 	const double referentPressure;
 		// 1 bar
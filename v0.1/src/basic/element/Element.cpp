@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -30,31 +30,37 @@ using namespace std;
 
 //	Constructors ==========================================================
 Element::Element()
-	:id{0}, start{NULL}, end{NULL}, diameter{0},
-	length{0}, roughness{0}, material{}, flow{0},
-	celerity{0}, spatialStep{0}, courantNo{0},
-	mesh{NULL}, meshOld{NULL}, meshSize{0} {}
+	:id{0}, label{0}, start{NULL}, end{NULL}, diameter{0},
+	length{0}, thickness{0}, roughness{0}, material{}, flow{0},
+	celerity{0}, spatialStep{0}, courantNo{0}, rate{1}, lumped{false},
+	mesh{NULL}, meshOld{NULL}, meshSize{0}, arrival{NULL}, previous{NULL},
+	held{NULL} {}
 
 Element::Element(const int& i)
-	:id{i}, start{NULL}, end{NULL}, diameter{0},
-	length{0}, roughness{0}, material{}, flow{0},
-	celerity{0}, spatialStep{0}, courantNo{0},
-	mesh{NULL}, meshOld{NULL}, meshSize{0} {}
+	:id{i}, label{i}, start{NULL}, end{NULL}, diameter{0},
+	length{0}, thickness{0}, roughness{0}, material{}, flow{0},
+	celerity{0}, spatialStep{0}, courantNo{0}, rate{1}, lumped{false},
+	mesh{NULL}, meshOld{NULL}, meshSize{0}, arrival{NULL}, previous{NULL},
+	held{NULL} {}
+
+Element::Element(const Element& e)
+	:id{e.id}, label{e.label}, start{e.start}, end{e.end}, diameter{e.diameter},
+	length{e.length}, thickness{e.thickness}, roughness{e.roughness},
+	material{e.material}, flow{e.flow}, celerity{e.celerity},
+	spatialStep{0}, courantNo{0}, rate{1}, lumped{false}, mesh{NULL}, meshOld{NULL},
+	meshSize{0}, arrival{NULL}, previous{NULL}, held{NULL} {}
 
 Element::~Element()
 {
 	start = NULL;
 	end = NULL;
 
-	// delete mesh
-	for (int i {0}; i < meshSize; i++) {
-		delete mesh[i];
-		delete meshOld[i];
-	}
-	delete[] mesh;
-	delete[] meshOld;
+	// mesh is released by its arena
 	mesh = NULL;
 	meshOld = NULL;
+	arrival = NULL;
+	previous = NULL;
+	held = NULL;
 }
 
 //	Validation ============================================================
@@ -86,6 +92,11 @@ bool Element::hasEnd() const
 	return true;
 }
 
+bool Element::isLumped() const
+{
+	return lumped;
+}
+
 //	Operators =============================================================
 bool Element::operator== (const Element& e) const
 {
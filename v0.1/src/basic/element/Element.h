@@ -3,7 +3,7 @@
 // created:	9-9-2018
 // version:	0.3
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in:
@@ -25,11 +25,13 @@
 #include<ostream>
 #include<fstream>
 #include<string>
+#include<vector>
 
 #include"Node.h"
 #include"Material.h"
 #include"Fluid.h"
 #include"Settings.h"
+#include"Arena.h"
 
 //=============================================================================
 //	Element
@@ -37,8 +39,9 @@
 /* a pipe element with 1 start and 1 end Node
  * containter for Node pointers
  * - doesn't modify node contents
- * - doesn't create new nodes
- * - doesn't allocate new memory
+ * - doesn't create new nodes, apart from mesh
+ *   points constructed in an arena passed to
+ *   discretize(), which owns and releases them
 */
 // first element will have id = 1
 class Element {
@@ -46,19 +49,34 @@ public:
 	// constructors
 	Element();
 	Element(const int&);
+	Element(const Element&);
+		// copies element data, not the mesh
+		// start and end still point to nodes
+		//  of the original, rebind with
+		//  setStart() and setEnd()
 	~Element();
 
 	// accessors
 	int getId() const;
 		// get id of element
-	Node getStart() const;
+	int getLabel() const;
+		// get id of element in input
+	const Node& getStart() const;
 		// get start node of element
-	Node getEnd() const;
+		// - a view, node is not copied
+	const Node& getEnd() const;
 		// get end node of element
+		// - a view, node is not copied
 	Node*& getMeshNode(const int&) const;
 		// get a node pointer from mesh
 	Node*& getMeshOldNode(const int&) const;
 		// get a node pointer from meshOld
+	Node*& getArrivalNode(const int&) const;
+		// get the point next to end i as its
+		//  junction sees it
+	Node*& getDepartureNode(const int&) const;
+		// get point i of meshOld as the points
+		//  next to it see it
 	double getDiameter() const;
 		// get diameter of element
 	double getLength() const;
@@ -80,6 +98,8 @@ public:
 		//  Lewi-Courant number
 	int getMeshSize() const;
 		// get mesh size
+	int getRate() const;
+		// get rate class
 
 	// validation
 	bool isFull() const;
@@ -89,6 +109,9 @@ public:
 		// check if start is assigned
 	bool hasEnd() const;
 		// check if end is assigned
+	bool isLumped() const;
+		// check if solved at its junctions
+		//  instead of meshed
 	
 	// computation
 	double computeArea() const;
@@ -102,6 +125,11 @@ public:
 	double computeHeadLossC(const Fluid&) const;
 		// compute and store
 		//  head loss coefficient
+	double computeHeadLossD(const Fluid&, double&) const;
+		// compute derivative of the head
+		//  loss r q |q| with flow, with the
+		//  change of friction included
+		// - stores head loss coefficient
 	void computeCelerity(const Settings&);
 		// compute and store celerity
 		/* note:
@@ -113,13 +141,24 @@ public:
 		//  max Lewi-Currant number
 	double computeMomentumCorrection(const Settings&) const;
 		// compute momentum correction coefficient
-	void computeTransient(const Settings&, const int&);
+	int computeTransient(const Settings&, const int&);
 		// compute values in new
 		//  time step
+		// - points step every rate-th time step,
+		//   boundary points with the fastest
+		//   element of their junction
+		// - ends of a slower element step on
+		//   every step of their junction, see
+		//   couple()
+		// - returns number of points due
+		// - lumped elements and links are left
+		//   to the junction, see Lumped.h
 
 	// mutators
 	void setId(const int&);
-		// set id number of element
+		// set id and label of element
+	void renumber(const int&);
+		// set id of element, label is kept
 	void setStart(Node*&);
 		// set start node of element
 	void setEnd(Node*&);
@@ -138,10 +177,15 @@ public:
 		// set flow through element
 	void setSpatialStep(const double&);
 		// set spatial step
+	void setRate(const int&);
+		// set rate class, time steps of
+		//  settings per element step
+	void setLumped(const bool&);
+		// mark as solved at its junctions
 
 	// utility
-	void discretize();
-		// form mesh points
+	void discretize(Arena&);
+		// form mesh points in arena
 		// assign current values
 	void correctLocalLoss(Node*&, const Fluid&) const;
 		// correct heads for local losses
@@ -150,6 +194,10 @@ public:
 		// map current field values to mesh
 	void updateMesh() const;
 		// update old mesh with current values
+	void updateMesh(const int&) const;
+		// update old mesh with values of
+		//  points due in time step, and the
+		//  points next to faster junctions
 	std::ostream& log(std::ostream&) const;
 		// log output
 	std::ofstream& writeVelocity(std::ofstream&) const;
@@ -166,6 +214,9 @@ public:
 		// write head from mesh
 	std::ofstream& writeCourant(std::ofstream&) const;
 		// write head from mesh
+	void sampleField(const int&, std::vector<double>&) const;
+		// copy field values from mesh
+		//  field ids as in Codec.h
 
 	bool operator== (const Element&) const;
 		// compares id only
@@ -178,7 +229,9 @@ public:
 
 private:
 	int id;
-		// id of element
+		// id of element, position in network
+	int label;
+		// id of element in input, used in output
 	Node* start;
 		// start node of element
 	Node* end;
@@ -202,6 +255,12 @@ private:
 		// spatial step of discretization
 	double courantNo;
 		// current max Lewi-Courant number
+	int rate;
+		// rate class, power of two multiple
+		//  of the time step of settings
+	bool lumped;
+		// true if solved at its junctions,
+		//  mesh holds only its ends
 	Node** mesh;
 		// array of computational nodes
 		//  in element in current time step
@@ -212,25 +271,42 @@ private:
 		// note: indexing starts from 0
 	int meshSize;
 		// number of nodes in mesh
+	Node** arrival;
+		// per end, the point next to it when its
+		//  characteristic reaches a faster junction
+		// NULL if rate is 1
+	Node** previous;
+		// per end, the point next to it at its
+		//  step before the one in meshOld
+	Node** held;
+		// per end, its state at the last step of
+		//  the element
 
 	// computation
+	double computeLocalLossC() const;
+		// compute local head loss coefficient
+		//  in the direction of flow
 	double computeFrictionCoeff(const Fluid&) const;
 		// compute friction coefficient
+	double computeFrictionCoeff(const Settings&, const double&) const;
+		// compute friction coefficient at mesh point
+	double computeFrictionCoeff(const double&, double&) const;
+		// compute friction coefficient at Reynolds
+		//  number, and Re d(lambda)/d(Re)
 		/* 
-		 * Re < 2300; lambda = 64/Re
-		 * Re > 2300; Colebrook-White expression
+		 * Re < 2320; lambda = 64/Re
+		 * Re > 4000; Colebrook-White expression
 		 * 
 		 * note:
 		 *
 		 * transitional flow, ie.
 		 *
-		 * 2300 < Re < 4000
+		 * 2320 < Re < 4000
 		 *
-		 * is also calculated using
-		 * Colebrook-White
+		 * is interpolated linearly in Re, so
+		 * that lambda is continuous for the
+		 * steady solver
 		 */
-	double computeFrictionCoeff(const Settings&, const double&) const;
-		// compute friction coefficient at mesh point
 	double colebrookWhite(const double&, const double&) const;
 		// Colebrook-White formula
 		//  for flow friction coefficient
@@ -242,6 +318,13 @@ private:
 	// utility
 	void computeMeshSize();
 		// compute and store mesh size
+	int computeRate(const int&) const;
+		// rate of mesh point, junctions step
+		//  with their fastest element
+	bool isCoupled(const int&) const;
+		// check if end steps with a faster junction
+	void couple(const int&, const int&) const;
+		// set arrival node of end for time step
 };
 
 //	Utility ===============================================================
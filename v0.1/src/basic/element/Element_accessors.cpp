@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -32,7 +32,12 @@ int Element::getId() const
 	return id;
 }
 
-Node Element::getStart() const
+int Element::getLabel() const
+{
+	return label;
+}
+
+const Node& Element::getStart() const
 {
 	// check if Node is present
 	if (start == NULL)
@@ -40,7 +45,7 @@ Node Element::getStart() const
 	return *start;
 }
 
-Node Element::getEnd() const
+const Node& Element::getEnd() const
 {
 	// check if Node is present
 	if (end == NULL)
@@ -64,6 +69,28 @@ Node*& Element::getMeshOldNode(const int& i) const
 	return meshOld[i];
 }
 
+Node*& Element::getArrivalNode(const int& i) const
+{
+	if (i != 0 && i != meshSize-1)
+		throw runtime_error("Element::getArrivalNode(): index");
+
+	if (this->isCoupled(i))
+		return arrival[i != 0];
+
+	return (i == 0) ? meshOld[1] : meshOld[meshSize-2];
+}
+
+Node*& Element::getDepartureNode(const int& i) const
+{
+	if (i < 0 || i >= meshSize)
+		throw runtime_error("Element::getDepartureNode(): index");
+
+	if ((i == 0 || i == meshSize-1) && this->isCoupled(i))
+		return held[i != 0];
+
+	return meshOld[i];
+}
+
 double Element::getDiameter() const
 {
 	return diameter;
@@ -114,3 +141,8 @@ int Element::getMeshSize() const
 	return meshSize;
 }
 
+int Element::getRate() const
+{
+	return rate;
+}
+
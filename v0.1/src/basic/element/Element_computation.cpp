@@ -6,7 +6,7 @@
 // tested:
 // status:
 //
-// last edit:	17-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -25,6 +25,7 @@
 #include"Settings.h"
 #include"Constant.h"
 #include"Utility.h"
+#include"Profile.h"
 using namespace std;
 
 //=============================================================================
@@ -70,27 +71,48 @@ double Element::computeHeadLossC(const Fluid& fluid) const
 	// compute friction head loss coefficient
 	double r {friction * 8 * length / (pow(diameter, 5) * GRAVITY * pow(PI, 2))};
 
-	// compute local head loss coefficient
-	double k {0};
-	if (flow < 0) {
-		k = end->getLoss();
-		// include spouting loss coefficient
-		if (start->getType() == Node::RESERVOIR)
-			k += start->getLoss();
-	}
-	else if (flow > 0) {
-		k = start->getLoss();
-		// include spouting loss coefficient
-		if (end->getType() == Node::RESERVOIR)
-			k += end->getLoss();
-	}
-
 	// sum
-	return 	r + 8 * k / (pow(diameter, 4) * GRAVITY * pow(PI, 2));
+	return 	r + this->computeLocalLossC();
+}
+
+double Element::computeHeadLossD(const Fluid& fluid, double& r) const
+	/*
+	 * h = (c_f lambda(Re) + c_k) q |q|, Re = Re_1 |q|
+	 *
+	 * dh/dq = 2 r |q| + c_f Re d(lambda)/d(Re) |q|
+	 *
+	 * laminar friction gives c_f 64 / Re_1, also
+	 * at zero flow
+	 */
+{
+	double re_1 {fluid.getDensity() * diameter
+				 / (fluid.getViscosity() * this->computeArea())};
+		// Reynolds number per unit flow
+	double c_f {8 * length / (pow(diameter, 5) * GRAVITY * pow(PI, 2))};
+		// friction head loss coefficient per lambda
+	double c_k {this->computeLocalLossC()};
+		// local head loss coefficient
+	double slope;
+		// Re d(lambda)/d(Re)
+	double q {abs(flow)};
+
+	r = c_f * this->computeFrictionCoeff(re_1 * q, slope) + c_k;
+
+	// laminar friction is linear in flow
+	if (re_1 * q < RE_LAMINAR)
+		return c_f * 64 / re_1 + 2 * c_k * q;
+
+	return 2 * r * q + c_f * slope * q;
 }
 
 void Element::computeCelerity(const Settings& settings)
 {
+	// use override if set
+	if (settings.celerity > 0) {
+		celerity = settings.celerity;
+		return;
+	}
+
 	celerity = sqrt(1 / (settings.fluid.getDensity() *
 						 (1 / settings.fluid.getBulkModulus()
 						  + diameter / (material.getModulus() * thickness))));
@@ -108,7 +130,7 @@ void Element::computeCourantNo(const Settings& settings)
 		throw runtime_error("Element::computeCourantNo(): mesh");
 	
 	// compute and store
-	courantNo = (celerity * settings.timeStep ) / spatialStep;
+	courantNo = (celerity * settings.timeStep * rate) / spatialStep;
 
 	// check
 	if (courantNo < 0 || courantNo > 1) {
@@ -151,7 +173,7 @@ double Element::computeMomentumCorrection(const Settings& settings) const
 	return beta;
 }
 
-void Element::computeTransient(const Settings& settings, const int& counter)
+int Element::computeTransient(const Settings& settings, const int& counter)
 {
 	Node* n;
 	Loop* l;
@@ -160,16 +182,42 @@ void Element::computeTransient(const Settings& settings, const int& counter)
 	vector<double> characteristic;
 	int pos;
 	pair<double, double> p;
+	int r;
+		// rate of point
+	int local;
+		// time step of point
+	int due {0};
+		// number of points due
+	bool junction;
+		// true if a lumped link makes the head
+		//  of the junction
+
+	// ends are set with the junction
+	if (lumped)
+		return due;
 
 	for (int i {0}; i < meshSize; i++) {
-		// even nodes on even time steps, odd nodes on odd timesteps
-		if (counter % 2 == 0 || counter == 0) {
-			if (i % 2 != 0 && i != 0) {
+		// step with rate of point, junctions
+		//  are held between steps
+		r = rate;
+		if (i == 0 || i == meshSize-1)
+			r = this->computeRate(i);
+		if (counter % r != 0) {
+			continue;
+		}
+		local = counter / r;
+		due++;
+
+		// even nodes on even time steps, odd nodes on odd timesteps,
+		//  ends coupled to faster junctions on every step of the
+		//  junction, see couple()
+		if (local % 2 == 0 || local == 0) {
+			if (i % 2 != 0 && i != 0 && !this->isCoupled(i)) {
 				continue;
 			}
 		}
-		else if (counter % 2 == 1 || counter == 1) {
-			if (i % 2 != 1 && i != 1) {
+		else if (local % 2 == 1 || local == 1) {
+			if (i % 2 != 1 && i != 1 && !this->isCoupled(i)) {
 				continue;
 			}
 		}
@@ -181,15 +229,23 @@ void Element::computeTransient(const Settings& settings, const int& counter)
 		// reset characteristic
 		characteristic.clear();
 		characteristic.resize(0);
+		lengths.clear();
 
 		// assign characteristics
+		junction = false;
 		// boundary
 		if (i == 0 || i == meshSize-1) {
 			// handle neighbour characteristics
 			for (int j {0}; j < l->getSize(); j++) {
+				// lumped links are not neighbours
+				if (l->getElement(j+1)->isLumped()) {
+					junction = true;
+					continue;
+				}
+
 				// store position of current element
 				if (id == l->getElement(j+1)->getId()) {
-					pos = j;
+					pos = characteristic.size();
 				}
 
 				p = make_pair(l->getElement(j+1)->getDiameter(),
@@ -215,7 +271,10 @@ void Element::computeTransient(const Settings& settings, const int& counter)
 		}
 
 		// compute
-		n->computeTransient(lengths, characteristic, pos, settings);
+		if (junction)
+			n->computeHeadBoundary(lengths, characteristic, pos, settings);
+		else
+			n->computeTransient(lengths, characteristic, pos, settings);
 
 		// recompute friction
 		if (i == 0) {
@@ -233,63 +292,66 @@ void Element::computeTransient(const Settings& settings, const int& counter)
 									 n->getDownstreamVelocity()));
 		}
 	}
+
+	return due;
 }
 
 //=============================================================================
 //	Private
 
-double Element::computeFrictionCoeff(const Fluid& fluid) const
+double Element::computeLocalLossC() const
 {
-	double f_old {0.015};
-		// initial guess
-	double f_new {0};
-		// new value
-	double re {0};
-		// Reynolds number
-
-	// compute Reynolds
-	re = this->computeReynolds(fluid);
-
-	// compute f_new
-	if (re == 0) {
-		return f_new;
+	// compute local head loss coefficient
+	double k {0};
+	if (flow < 0) {
+		k = end->getLoss();
+		// include spouting loss coefficient
+		if (start->getType() == Node::RESERVOIR)
+			k += start->getLoss();
 	}
-	// laminar
-	else if (re < RE_LAMINAR) {
-		return 64/re;
+	else if (flow > 0) {
+		k = start->getLoss();
+		// include spouting loss coefficient
+		if (end->getType() == Node::RESERVOIR)
+			k += end->getLoss();
 	}
-	// turbulent
-	else {
-		// iterate untill convergence
-		for (int i {0}; i < MAX_ITER; i++) {
-			// turbulent and transitional
-			f_new = this->colebrookWhite(f_old, re);
 
-			// check if converged
-			if (EPS > abs(f_old-f_new))
-				break;
+	return 8 * k / (pow(diameter, 4) * GRAVITY * pow(PI, 2));
+}
 
-			// reset
-			f_old = f_new;
-		}
-	}
+double Element::computeFrictionCoeff(const Fluid& fluid) const
+{
+	double slope;
+		// Re d(lambda)/d(Re), unused
 
-	return f_new;
+	return this->computeFrictionCoeff(this->computeReynolds(fluid), slope);
 }
 
 double Element::computeFrictionCoeff(const Settings& settings,
 									 const double& v) const
 {
 	// steady friction
+	double slope;
+		// Re d(lambda)/d(Re), unused
+
+	return this->computeFrictionCoeff(this->computeReynolds(settings.fluid, v),
+									  slope);
+}
+
+double Element::computeFrictionCoeff(const double& re, double& slope) const
+{
 	double f_old {0.015};
 		// initial guess
 	double f_new {0};
 		// new value
-	double re {0};
-		// Reynolds number
+	double x;
+		// 1/sqrt(lambda)
+	double s;
+		// argument of Colebrook-White
+	double c {2 / std::log(10.0)};
+		// 2 / ln 10
 
-	// compute Reynolds
-	re = this->computeReynolds(settings.fluid, v);
+	slope = 0;
 
 	// compute f_new
 	if (re < EPS) {
@@ -297,12 +359,26 @@ double Element::computeFrictionCoeff(const Settings& settings,
 	}
 	// laminar
 	else if (re < RE_LAMINAR) {
-		f_new = 64 / re;
+		slope = -64 / re;
+		return 64 / re;
+	}
+	// transitional, between the laminar and
+	//  the turbulent end
+	else if (re < RE_TURBULENT) {
+		double f_t {this->computeFrictionCoeff(RE_TURBULENT, slope)};
+		double f_l {64 / RE_LAMINAR};
+
+		slope = re * (f_t - f_l) / (RE_TURBULENT - RE_LAMINAR);
+		return f_l + (re - RE_LAMINAR) * (f_t - f_l) / (RE_TURBULENT - RE_LAMINAR);
 	}
 	// turbulent
 	else {
+		int iterations {0};
+
 		// iterate untill convergence
 		for (int i {0}; i < MAX_ITER; i++) {
+			iterations++;
+
 			// turbulent and transitional
 			f_new = this->colebrookWhite(f_old, re);
 
@@ -313,8 +389,16 @@ double Element::computeFrictionCoeff(const Settings& settings,
 			// reset
 			f_old = f_new;
 		}
+		Profile::count(Profile::COLEBROOK_ITERATIONS, iterations);
 	}
 
+	// implicit derivative of
+	//  x + c ln(e / 3.7075 D + 2.523 x / Re) = 0
+	x = 1 / sqrt(f_new);
+	s = roughness / (3.7075 * diameter) + 2.523 * x / re;
+	slope = -2 * f_new / x * (c * 2.523 * x / (re * s))
+			/ (1 + c * 2.523 / (re * s));
+
 	return f_new;
 }
 
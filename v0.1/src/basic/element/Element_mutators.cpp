@@ -6,12 +6,13 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
 
 
+#include<stdexcept>
 #include<string>
 
 #include"Element.h"
@@ -28,6 +29,12 @@ using namespace std;
 //	Public
 
 void Element::setId(const int& i)
+{
+	id = i;
+	label = i;
+}
+
+void Element::renumber(const int& i)
 {
 	id = i;
 }
@@ -77,3 +84,17 @@ void Element::setSpatialStep(const double& i)
 	spatialStep = i;
 }
 
+void Element::setRate(const int& i)
+{
+	// powers of two keep classes nested
+	if (i < 1 || (i & (i - 1)) != 0)
+		throw runtime_error("Element::setRate(): rate");
+
+	rate = i;
+}
+
+void Element::setLumped(const bool& i)
+{
+	lumped = i;
+}
+
@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -21,6 +21,8 @@
 #include<ios>
 #include<cstring>
 #include<cmath>
+#include<vector>
+#include<algorithm>
 
 #include"Element.h"
 #include"Node.h"
@@ -28,8 +30,10 @@
 #include"Fluid.h"
 #include"Material.h"
 #include"Settings.h"
+#include"Arena.h"
 #include"Constant.h"
 #include"Utility.h"
+#include"Codec.h"
 #include"WeightingFunctionCoefficients.h"
 using namespace std;
 
@@ -40,13 +44,13 @@ using namespace std;
 //=============================================================================
 //	Public
 
-void Element::discretize()
+void Element::discretize(Arena& arena)
 {
 	this->computeMeshSize();	
 	
 	// allocate
-	mesh = new Node* [meshSize] {};
-	meshOld = new Node* [meshSize] {};
+	mesh = arena.makeArray<Node>(meshSize);
+	meshOld = arena.makeArray<Node>(meshSize);
 
 	Node* n;
 
@@ -59,14 +63,27 @@ void Element::discretize()
 		// new boundary
 		// allocate defined in Node.h
 		if (i == 0 || i == meshSize-1) {
-			allocate(mesh[i], n);
-			allocate(meshOld[i], n);
+			allocate(mesh[i], n, arena);
+			allocate(meshOld[i], n, arena);
 			*mesh[i] = *n;
 		}
 		// new internal
 		else {
-			mesh[i] = new Node{};
-			meshOld[i] = new Node{};
+			mesh[i] = arena.make<Node>();
+			meshOld[i] = arena.make<Node>();
+		}
+	}
+
+	// slower elements may meet faster junctions
+	if (rate > 1) {
+		arrival = arena.makeArray<Node>(2);
+		previous = arena.makeArray<Node>(2);
+		held = arena.makeArray<Node>(2);
+
+		for (int k {0}; k < 2; k++) {
+			arrival[k] = arena.make<Node>();
+			previous[k] = arena.make<Node>();
+			held[k] = arena.make<Node>();
 		}
 	}
 }
@@ -76,6 +93,57 @@ void Element::updateMesh() const
 	for (int i {0}; i < meshSize; i++) {
 		*meshOld[i] = *mesh[i];
 	}
+
+	// restart coupling to faster junctions
+	for (int i : {0, meshSize-1}) {
+		if (this->isCoupled(i)) {
+			*held[i != 0] = *mesh[i];
+			*previous[i != 0] = *meshOld[(i == 0) ? 1 : meshSize-2];
+			*arrival[i != 0] = *previous[i != 0];
+		}
+	}
+}
+
+void Element::updateMesh(const int& counter) const
+{
+	int p;
+		// point next to end
+
+	// element due
+	if (counter % rate == 0) {
+		for (int i : {0, meshSize-1}) {
+			p = (i == 0) ? 1 : meshSize-2;
+
+			// keep the point next to a faster junction
+			//  before it changes
+			if (this->isCoupled(i) && (counter / rate) % 2 == p % 2)
+				*previous[i != 0] = *meshOld[p];
+		}
+
+		for (int i {0}; i < meshSize; i++) {
+			*meshOld[i] = *mesh[i];
+		}
+
+		// ends as the element stepped with them
+		for (int i : {0, meshSize-1}) {
+			if (this->isCoupled(i))
+				*held[i != 0] = *mesh[i];
+		}
+	}
+	// element not due, only junctions may be
+	else {
+		for (int i : {0, meshSize-1}) {
+			if (counter % this->computeRate(i) == 0)
+				*meshOld[i] = *mesh[i];
+		}
+	}
+
+	// characteristics reaching faster junctions
+	//  in the next time step
+	for (int i : {0, meshSize-1}) {
+		if (this->isCoupled(i) && (counter + 1) % this->computeRate(i) == 0)
+			this->couple(i, counter + 1);
+	}
 }
 
 ostream& Element::log(ostream& os) const
@@ -90,11 +158,11 @@ ostream& Element::log(ostream& os) const
 	os << setprecision(3)
 	   << left
 	   << s_3
-	   << setw(5) << id
+	   << setw(5) << label
 	   << s_3
-	   << setw(6) << start->getId()
+	   << setw(6) << start->getLabel()
 	   << s_3
-	   << setw(6) << end->getId()
+	   << setw(6) << end->getLabel()
 	   << s_2
 	   << showpoint
 	   << scientific
@@ -193,6 +261,34 @@ ofstream& Element::writeGasFraction(ofstream& ofs) const
 	return ofs;
 }
 
+void Element::sampleField(const int& field, vector<double>& values) const
+{
+	values.resize(meshSize);
+
+	for (int i {0}; i < meshSize; i++) {
+		switch (field) {
+			case Codec::VELOCITY:
+				values[i] = meshOld[i]->getVelocity();
+				break;
+			case Codec::HEAD:
+				values[i] = meshOld[i]->getHead();
+				break;
+			case Codec::PRESSURE:
+				values[i] = meshOld[i]->getPressure();
+				break;
+			case Codec::FRICTION:
+				values[i] = 0.5 * (meshOld[i]->getUpstreamFriction() +
+								   meshOld[i]->getDownstreamFriction());
+				break;
+			case Codec::GAS_FRACTION:
+				values[i] = meshOld[i]->getGasFraction();
+				break;
+			default:
+				throw runtime_error("Element::sampleField(): field");
+		}
+	}
+}
+
 //=============================================================================
 //	Private
 
@@ -204,6 +300,67 @@ void Element::computeMeshSize()
 	meshSize = int(ceil(length/spatialStep)) + 1;
 }
 
+int Element::computeRate(const int& i) const
+{
+	// internal
+	if (i != 0 && i != meshSize-1)
+		return rate;
+
+	// boundary
+	Loop* l {mesh[i]->links};
+	int r {rate};
+
+	for (int j {1}; j <= l->getSize(); j++) {
+		r = min(r, l->getElement(j)->rate);
+	}
+
+	return r;
+}
+
+bool Element::isCoupled(const int& i) const
+{
+	return arrival != NULL && this->computeRate(i) < rate;
+}
+
+void Element::couple(const int& i, const int& counter) const
+	// point next to end as its characteristic
+	//  reaches the junction
+	/*
+	 * the characteristic leaves point p one step
+	 * of the element, rate time steps, before it
+	 * reaches the junction; p steps on every other
+	 * step of the element, so the characteristic
+	 * is interpolated between those through its
+	 * last two states
+	 *
+	 * while the newer one is not due, it is taken
+	 * from point q one segment further along the
+	 * same characteristic, as p will be computed
+	 */
+{
+	const int p {(i == 0) ? 1 : meshSize-2};
+	const int q {(i == 0) ? 2 : meshSize-3};
+	const int departure {counter - rate};
+		// time step the characteristic leaves p
+	int last {(counter - 1) / rate};
+		// last element step p was computed on
+
+	if (last % 2 != p % 2)
+		last--;
+	last *= rate;
+
+	// between the last two states of p
+	if (departure < last) {
+		arrival[i != 0]->interpolate(*previous[i != 0], *meshOld[p],
+				(departure - last + 2 * rate) / (2.0 * rate));
+	}
+	// between p and q
+	else {
+		arrival[i != 0]->interpolate(*meshOld[p], *this->getDepartureNode(q),
+				(departure - last) / (2.0 * rate));
+	}
+}
+
 void Element::correctLocalLoss(Node*& n, const Fluid& fluid) const
 {
 	// check if valve
@@ -275,8 +432,8 @@ void Element::mapFields(const Settings& settings) const
 		// current position
 	const double nu {settings.fluid.getViscosity() / settings.fluid.getDensity()};
 		// dynamic viscosity
-	const double delta_tau {4 * nu * settings.timeStep / pow(diameter, 2)};
-		// dimensionless time step
+	double delta_tau {};
+		// dimensionless time step of point
 	const double re {this->computeReynolds(settings.fluid, v)};
 		// reynolds number
 	const double eps {roughness / diameter};
@@ -294,6 +451,8 @@ void Element::mapFields(const Settings& settings) const
 		n->setArea(this->computeArea());
 		n->setCelerity(celerity);
 		n->setReynolds(re);
+		n->setTimeStep(settings.timeStep * this->computeRate(i));
+		delta_tau = 4 * nu * n->getTimeStep() / pow(diameter, 2);
 
 		// skip boundary
 		if (i != 0 && i != meshSize-1) {
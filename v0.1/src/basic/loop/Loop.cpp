@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -196,17 +196,17 @@ bool Loop::isInit() const
 	return true;
 }
 
-void Loop::isZeroSize(const string& s) const
+void Loop::isZeroSize(const char* s) const
 	// check if size is > 0
 {
 	if (size < 1)
-		throw runtime_error("Loop::isZeroSize(): "+s);
+		throw runtime_error(string("Loop::isZeroSize(): ")+s);
 }
 
-void Loop::checkBounds(const int& i, const string& s) const
+void Loop::checkBounds(const int& i, const char* s) const
 	// i = id
 {
 	if (i > size || i < 1)
-		throw runtime_error("Loop::checkBounds(): "+s);
+		throw runtime_error(string("Loop::checkBounds(): ")+s);
 }
 
@@ -3,7 +3,7 @@
 // created:	6-9-2018
 // version:	0.2
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in:
@@ -94,11 +94,11 @@ public:
 		// -1 if loop size == 0
 		// 0 if loop is empty
 		// only use on sequentially filled loops!
-	Node firstFree() const;
+	const Node& firstFree() const;
 		// get starting node of loop
 		//  based on orientation
 		// only use on sequentially filled loops!
-	Node lastFree() const;
+	const Node& lastFree() const;
 		// get ending node of loop
 		//  based on orientation
 		// loop doesn't need to be full
@@ -173,9 +173,9 @@ private:
 	bool isInit() const;
 		// check if loop is initialised
 		// returns false if any element is NULL
-	void isZeroSize(const std::string&) const;
+	void isZeroSize(const char*) const;
 		// check if loop size is zero
-	void checkBounds(const int&, const std::string&) const;
+	void checkBounds(const int&, const char*) const;
 		// check if trying to access out of bounds
 };
 
@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -50,7 +50,7 @@ int Loop::getTerminus() const
 	return i;
 }
 
-Node Loop::firstFree() const
+const Node& Loop::firstFree() const
 	// get "free" node of first element in loop
 	//  based on orientation
 {
@@ -67,7 +67,7 @@ Node Loop::firstFree() const
 	return loop[0]->getEnd();
 }
 
-Node Loop::lastFree() const
+const Node& Loop::lastFree() const
 	// get free node of last stored element in loop
 	//  based on orientation
 	// if loop is full will return "free" node of last element
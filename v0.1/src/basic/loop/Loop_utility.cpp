@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -40,7 +40,7 @@ ostream& Loop::log(ostream& os) const
 		else
 			s = " -";
 
-		os << s << loop[i-1]->getId();
+		os << s << loop[i-1]->getLabel();
 
 		// ending bracket or separator
 		if (i == size) {
@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
@@ -40,20 +40,20 @@ using namespace std;
 Node::Node(Type t)
 	:links{NULL}, upstreamCoeff{}, downstreamCoeff{},
 	neighbour_{NULL}, neighbours_{}, type{t},
-	id{0}, head{0}, pressure{0}, elevation{0}, loss{0},
+	id{0}, label{0}, head{0}, pressure{0}, elevation{0}, loss{0},
 	velocity{0}, eventStart{-1}, eventEnd{-1}, eventState{false},
-	area_{0}, celerity_{0}, gasFraction_{-1}, momentumCorrection_{0},
-	reynolds_{0}, aScale_{0}, bScale_{0},
+	fixedHead{false}, area_{0}, celerity_{0}, gasFraction_{-1},
+	momentumCorrection_{0}, timeStep_{0}, reynolds_{0}, aScale_{0}, bScale_{0},
 	upstreamFriction_{}, downstreamFriction_{},
 	upstreamVelocity_{}, downstreamVelocity_{} {}
 
 Node::Node(Type t, const int& i)
 	:links{NULL}, upstreamCoeff{}, downstreamCoeff{},
 	neighbour_{NULL}, neighbours_{}, type{t},
-	id{i}, head{0}, pressure{0}, elevation{0}, loss{0},
+	id{i}, label{i}, head{0}, pressure{0}, elevation{0}, loss{0},
 	velocity{0}, eventStart{-1}, eventEnd{-1}, eventState{false},
-	area_{0}, celerity_{0}, gasFraction_{-1}, momentumCorrection_{0},
-	reynolds_{0}, aScale_{0}, bScale_{0},
+	fixedHead{false}, area_{0}, celerity_{0}, gasFraction_{-1},
+	momentumCorrection_{0}, timeStep_{0}, reynolds_{0}, aScale_{0}, bScale_{0},
 	upstreamFriction_{}, downstreamFriction_{},
 	upstreamVelocity_{}, downstreamVelocity_{} {}
 
@@ -64,20 +64,20 @@ Node::Node(Type t, const int& i)
 Node::Node()
 	:links{NULL}, upstreamCoeff{}, downstreamCoeff{},
 	neighbour_{NULL}, neighbours_{}, type{NODE},
-	id{0}, head{0}, pressure{0}, elevation{0}, loss{0},
+	id{0}, label{0}, head{0}, pressure{0}, elevation{0}, loss{0},
 	velocity{0}, eventStart{-1}, eventEnd{-1}, eventState{false},
-	area_{0}, celerity_{0}, gasFraction_{-1}, momentumCorrection_{0},
-	reynolds_{0}, aScale_{0}, bScale_{0},
+	fixedHead{false}, area_{0}, celerity_{0}, gasFraction_{-1},
+	momentumCorrection_{0}, timeStep_{0}, reynolds_{0}, aScale_{0}, bScale_{0},
 	upstreamFriction_{}, downstreamFriction_{},
 	upstreamVelocity_{}, downstreamVelocity_{} {}
 
 Node::Node(const int& i)
 	:links{NULL}, upstreamCoeff{}, downstreamCoeff{},
 	neighbour_{NULL}, neighbours_{}, type{NODE},
-	id{i}, head{0}, pressure{0}, elevation{0}, loss{0},
+	id{i}, label{i}, head{0}, pressure{0}, elevation{0}, loss{0},
 	velocity{0}, eventStart{-1}, eventEnd{-1}, eventState{false},
-	area_{0}, celerity_{0}, gasFraction_{-1}, momentumCorrection_{0},
-	reynolds_{0}, aScale_{0}, bScale_{0},
+	fixedHead{false}, area_{0}, celerity_{0}, gasFraction_{-1},
+	momentumCorrection_{0}, timeStep_{0}, reynolds_{0}, aScale_{0}, bScale_{0},
 	upstreamFriction_{}, downstreamFriction_{},
 	upstreamVelocity_{}, downstreamVelocity_{} {}
 
@@ -95,6 +95,11 @@ int Node::getId() const
 	return id;
 }
 
+int Node::getLabel() const
+{
+	return label;
+}
+
 double Node::getHead() const
 {
 	return head;
@@ -148,6 +153,11 @@ bool Node::getEventState() const
 	return eventState;
 }
 
+bool Node::isFixed() const
+{
+	return fixedHead;
+}
+
 Node* Node::getNeighbour() const
 {
 	return neighbour_;
@@ -173,6 +183,11 @@ double Node::getMomentumCorrection() const
 	return momentumCorrection_;
 }
 
+double Node::getTimeStep() const
+{
+	return timeStep_;
+}
+
 double Node::getUpstreamFriction() const
 {
 	return upstreamFriction_;
@@ -222,7 +237,7 @@ void Node::computeTransient(const vector<pair<double, double>>& el,
 	this->computeTransientParameters(c, a, K, P, el, pos, ch, settings);
 	
 	// constants
-	double delta_t {settings.timeStep};
+	double delta_t {timeStep_};
 	double Z {elevation};
 	double h_v {settings.fluid.getVapourHead()};
 	double psi {settings.weightingFactor};
@@ -315,6 +330,34 @@ void Node::computeTransient(const vector<pair<double, double>>& el,
 	this->computeCoefficients(settings, pos, el);
 }
 
+void Node::computeHeadBoundary(const vector<pair<double, double>>& el,
+							   const vector<double>& ch, const int& pos,
+							   const Settings& settings)
+{
+	vector<double> c {};
+		// celerity at neighbouring nodes
+	vector<double> a {};
+		// area at neighbouring nodes
+	vector<double> K {};
+		// coefficients
+	vector<double> P {};
+		// coefficients
+
+	this->computeTransientParameters(c, a, K, P, el, pos, ch, settings);
+
+	// compute velocity
+	if (ch[pos] > 0) {
+		upstreamVelocity_ = (K[pos] - head) / (P[pos] * a[pos]);
+		velocity = upstreamVelocity_;
+	}
+	else {
+		downstreamVelocity_ = (head - K[pos]) / (P[pos] * a[pos]);
+		velocity = downstreamVelocity_;
+	}
+
+	this->computeCoefficients(settings, pos, el);
+}
+
 void Node::computeTransientParameters(vector<double>& c, vector<double>& a,
 									  vector<double>& K, vector<double>& P,
 									  const vector<pair<double, double>>& el,
@@ -383,10 +426,11 @@ void Node::computeTransientParameters(vector<double>& c, vector<double>& a,
 			coeffs = &downstreamCoeff;
 		}
 		h = n->head;
-		delta_tau = 4 * nu * settings.timeStep / pow(el[i].first, 2);
+		delta_tau = 4 * nu * timeStep_ / pow(el[i].first, 2);
 
-		// compute sums
-		for (int j {0}; j < coeffs->size(); j++) {
+		// compute sums, coefficients stored for another
+		//  flow regime may outnumber the fit
+		for (int j {0}; j < int(coeffs->size()) && j < int(n_k->size()); j++) {
 			a_sum += exp(-1 * ((*n_k)[j] + bScale_) * delta_tau) * (*m_k)[j] * aScale_;
 			b_sum += exp(-2 * ((*n_k)[j] + bScale_) * delta_tau) * (*coeffs)[j];
 		}
@@ -430,7 +474,7 @@ void Node::computeCoefficients(const Settings& settings, const int& pos,
 
 	const double nu {settings.fluid.getViscosity() / settings.fluid.getDensity()};
 		// dynamic viscosity
-	const double delta_tau {4 * nu * settings.timeStep / pow(el[pos_id].first, 2)};
+	const double delta_tau {4 * nu * timeStep_ / pow(el[pos_id].first, 2)};
 		// dimensionless timestep
 	double exponent {};
 	const vector<double>* m_k {};
@@ -446,8 +490,10 @@ void Node::computeCoefficients(const Settings& settings, const int& pos,
 		n_k = &settings.turbulentCoeff.n_k;
 	}
 
+	// coefficients stored for another flow
+	//  regime may outnumber the fit
 	if (upstreamCoeff.size() != 0) {
-		for (int i {0}; i < upstreamCoeff.size(); i++) {
+		for (int i {0}; i < int(upstreamCoeff.size()) && i < int(n_k->size()); i++) {
 			exponent = exp(-1 * ((*n_k)[i] + bScale_ ) * delta_tau);
 			upstreamCoeff[i] = exponent * (exponent * upstreamCoeff[i] +
 							   (*m_k)[i] * aScale_ *
@@ -455,7 +501,7 @@ void Node::computeCoefficients(const Settings& settings, const int& pos,
 		}
 	}
 	if (downstreamCoeff.size() != 0) {
-		for (int i {0}; i < downstreamCoeff.size(); i++) {
+		for (int i {0}; i < int(downstreamCoeff.size()) && i < int(n_k->size()); i++) {
 			exponent = exp(-1 * ((*n_k)[i] + bScale_ ) * delta_tau);
 			downstreamCoeff[i] = exponent * (exponent * downstreamCoeff[i] +
 								 (*m_k)[i] * aScale_ *
@@ -466,6 +512,12 @@ void Node::computeCoefficients(const Settings& settings, const int& pos,
 
 //	Mutators ==============================================================
 void Node::setId(const int& i)
+{
+	id = i;
+	label = i;
+}
+
+void Node::renumber(const int& i)
 {
 	id = i;
 }
@@ -510,6 +562,11 @@ void Node::setEventState(const bool& i)
 	eventState = i;
 }
 
+void Node::setFixed(const bool& i)
+{
+	fixedHead = i;
+}
+
 void Node::setCelerity(const double& celerity)
 {
 	celerity_ = celerity;
@@ -530,6 +587,11 @@ void Node::setMomentumCorrection(const double& momentumCorrection)
 	momentumCorrection_ = momentumCorrection;
 }
 
+void Node::setTimeStep(const double& timeStep)
+{
+	timeStep_ = timeStep;
+}
+
 void Node::setNeighbour(Node*& n)
 {
 	neighbour_ = n;
@@ -577,6 +639,20 @@ void Node::setDownstreamVelocity(const double& velocity)
 	downstreamVelocity_ = velocity;
 }
 
+void Node::interpolate(const Node& a, const Node& b, const double& w)
+{
+	*this = a;
+
+	head += w * (b.head - a.head);
+	pressure += w * (b.pressure - a.pressure);
+	velocity += w * (b.velocity - a.velocity);
+	gasFraction_ += w * (b.gasFraction_ - a.gasFraction_);
+	upstreamFriction_ += w * (b.upstreamFriction_ - a.upstreamFriction_);
+	downstreamFriction_ += w * (b.downstreamFriction_ - a.downstreamFriction_);
+	upstreamVelocity_ += w * (b.upstreamVelocity_ - a.upstreamVelocity_);
+	downstreamVelocity_ += w * (b.downstreamVelocity_ - a.downstreamVelocity_);
+}
+
 //	Utility ===============================================================
 bool Node::handleInput(const string& tag, const string& num)
 {
@@ -640,7 +716,7 @@ ostream& Node::log(ostream& os) const
 	os << setprecision(3)
 	   << left
 	   << s_3
-	   << setw(5) << id
+	   << setw(5) << label
 	   << s_3
 	   << setw(5) << this->getType()
 	   << showpoint
@@ -712,6 +788,7 @@ Node& Node::operator= (const Node& n)
 		neighbours_[i] = n.neighbours_[i];
 	}
 	id = n.id;
+	label = n.label;
 	head = n.head;
 	pressure = n.pressure;
 	elevation = n.elevation;
@@ -720,10 +797,12 @@ Node& Node::operator= (const Node& n)
 	eventStart = n.eventStart;
 	eventEnd = n.eventEnd;
 	eventState = n.eventState;
+	fixedHead = n.fixedHead;
 	area_ = n.area_;
 	celerity_ = n.celerity_;
 	gasFraction_ = n.gasFraction_;
 	momentumCorrection_ = n.momentumCorrection_;
+	timeStep_ = n.timeStep_;
 	reynolds_ = n.reynolds_;
 	aScale_ = n.aScale_;
 	bScale_ = n.bScale_;
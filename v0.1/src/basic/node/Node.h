@@ -3,7 +3,7 @@
 // created:	9-9-2018
 // version:	0.3
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in:
@@ -29,6 +29,7 @@
 
 #include"Fluid.h"
 #include"Settings.h"
+#include"Arena.h"
 
 class Loop;
 
@@ -75,6 +76,8 @@ public:
 		// return type
 	int getId() const;
 		// get id of node
+	int getLabel() const;
+		// get id of node in input
 	double getHead() const;
 		// get head at node
 	double getPressure() const;
@@ -93,6 +96,8 @@ public:
 		// get time of event ending
 	bool getEventState() const;
 		// get state of event
+	bool isFixed() const;
+		// check if head is fixed by input
 	Node* getNeighbour() const;
 		// get neighbour_
 	double getCelerity() const;
@@ -103,6 +108,8 @@ public:
 		// get gasFraction_
 	double getMomentumCorrection() const;
 		// get momentumCorrection_
+	double getTimeStep() const;
+		// get timeStep_
 	double getUpstreamFriction() const;
 	double getDownstreamFriction() const;
 	double getUpstreamVelocity() const;
@@ -117,6 +124,11 @@ public:
 								  const std::vector<double>&, const int&,
 								  const Settings&);
 		// compute state in new time step
+	void computeHeadBoundary(const std::vector<std::pair<double, double>>&,
+							 const std::vector<double>&, const int&,
+							 const Settings&);
+		// compute velocity in new time step
+		//  from the current head
 	void computeTransientParameters(std::vector<double>&, std::vector<double>&,
 							  		std::vector<double>&, std::vector<double>&,
 							  		const std::vector<std::pair<double, double>>&,
@@ -131,7 +143,9 @@ public:
 
 	// mutators
 	void setId(const int&);
-		// set id of node
+		// set id and label of node
+	void renumber(const int&);
+		// set id of node, label is kept
 	void setHead(const double&);
 		// set head at node
 	void setPressure(const double&);
@@ -148,6 +162,8 @@ public:
 		// set event end
 	void setEventState(const bool&);
 		// set event state
+	void setFixed(const bool&);
+		// mark head as fixed
 	void setCelerity(const double&);
 		// set celerity_
 	void setArea(const double&);
@@ -156,6 +172,8 @@ public:
 		// set gasFraction_
 	void setMomentumCorrection(const double&);
 		// set momentumCorrection_
+	void setTimeStep(const double&);
+		// set timeStep_
 	void setNeighbour(Node*&);
 		// store a neighbour_ node
 	void setNeighbours(Node*&);
@@ -168,6 +186,9 @@ public:
 	void setDownstreamFriction(const double&);
 	void setUpstreamVelocity(const double&);
 	void setDownstreamVelocity(const double&);
+	void interpolate(const Node&, const Node&, const double&);
+		// set state between two states of a
+		//  point, weight of the second
 	
 	// utility
 	virtual bool handleInput(const std::string&, const std::string&);
@@ -201,7 +222,9 @@ private:
 	Type type;
 		// type of this class
 	int id;
-		// id of node
+		// id of node, position in network
+	int label;
+		// id of node in input, used in output
 	double head;						// [m]
 		// hydraulic head at node
 	double pressure;					// [Pa]
@@ -220,6 +243,9 @@ private:
 		// time of event end
 	bool eventState;
 		// true if event finished
+	bool fixedHead;
+		// true if head is fixed by input
+		//  ie. pressure or head was given
 	double area_;
 		// cross-sectional area
 	double celerity_;
@@ -228,6 +254,9 @@ private:
 		// gas fraction at node
 	double momentumCorrection_;
 		// momentum correction coefficient
+	double timeStep_;					// [s]
+		// time step of node, a multiple of
+		//  the time step of settings
 	double reynolds_;
 		// Reynolds number
 	double aScale_;
@@ -315,6 +344,8 @@ public:
 	// accessors
 	double getLevel() const;
 		// get level
+	double getArea() const;
+		// get area
 
 	// computation
 	void computeHead(const Fluid&);
@@ -325,6 +356,8 @@ public:
 	// mutators
 	void setLevel(const double&);
 		// set level
+	void setArea(const double&);
+		// set area
 	
 	// utility
 	bool handleInput(const std::string&, const std::string&);
@@ -340,6 +373,9 @@ private:
 		// height of free surface of fluid
 		//  in reservoi with respect
 		//  to elevation
+	double area;						// [m2]
+		// area of free surface of fluid
+		//  0 if level is constant
 };
 
 //=============================================================================
@@ -422,8 +458,9 @@ inline Target* down_cast(Source* s)
 }
 
 template<class T>
-void allocate(T& t, Node* n)
-	// allocate space for base or derived Node class object
+void allocate(T& t, Node* n, Arena& arena)
+	// construct base or derived Node class object
+	//  of the same type as n in arena
 {
 	// check if T is pointer
 	if (std::is_pointer<T>::value == false)
@@ -432,19 +469,19 @@ void allocate(T& t, Node* n)
 	int type {n->getType()};
 	switch (type) {
 		case 1: {
-			t = new Node {};
+			t = arena.make<Node>();
 			break;
 		}
 		case 2: {
-			t = new Source {};
+			t = arena.make<Source>();
 			break;
 		}
 		case 3: {
-			t = new Reservoir {};
+			t = arena.make<Reservoir>();
 			break;
 		}
 		case 4: {
-			t = new Valve {};
+			t = arena.make<Valve>();
 			break;
 		}
 	}
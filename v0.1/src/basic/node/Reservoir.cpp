@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
@@ -32,10 +32,10 @@ using namespace std;
 
 //	Constructors ==========================================================
 Reservoir::Reservoir()
-	:Source{Node::RESERVOIR}, level{0} {}
+	:Source{Node::RESERVOIR}, level{0}, area{0} {}
 
 Reservoir::Reservoir(const int& i)
-	:Source{Node::RESERVOIR, i}, level{0} {}
+	:Source{Node::RESERVOIR, i}, level{0}, area{0} {}
 
 Reservoir::~Reservoir() {}
 
@@ -45,6 +45,11 @@ double Reservoir::getLevel() const
 	return level;
 }
 
+double Reservoir::getArea() const
+{
+	return area;
+}
+
 //	Computation ===========================================================
 void Reservoir::computeHead(const Fluid& fluid)
 {
@@ -63,6 +68,11 @@ void Reservoir::setLevel(const double& i)
 	level = i;
 }
 
+void Reservoir::setArea(const double& i)
+{
+	area = i;
+}
+
 //	Utility ===============================================================
 bool Reservoir::handleInput(const string& tag, const string& num)
 {
@@ -78,6 +88,11 @@ bool Reservoir::handleInput(const string& tag, const string& num)
 			throw runtime_error("Reservoir::handleInput()");
 		this->setLevel(stod(num));
 	}
+	else if (tag == "area") {
+		if (this->getArea() != 0)
+			throw runtime_error("Reservoir::handleInput()");
+		this->setArea(stod(num));
+	}
 	else {
 		valid = false;
 	}
@@ -102,8 +117,10 @@ ostream& Reservoir::log(ostream& os) const
 Reservoir& Reservoir::operator= (const Node& n)
 {
 	Source::operator= (n);
-	if (const Reservoir* r = down_cast<const Reservoir> (&n))
+	if (const Reservoir* r = down_cast<const Reservoir> (&n)) {
 		level = r->level;
+		area = r->area;
+	}
 
 	return *this;
 }
@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
@@ -76,28 +76,8 @@ void Source::computeTransient(const vector<pair<double, double>>& el,
 							  const vector<double>& ch, const int& pos,
 							  const Settings& settings)
 {
-	vector<double> c {};
-		// celerity at neighbouring nodes
-	vector<double> a {};
-		// area at neighbouring nodes
-	vector<double> K {};
-		// coefficients
-	vector<double> P {};
-		// coefficients
-
-	this->computeTransientParameters(c, a, K, P, el, pos, ch, settings);
-
-	// compute velocity
-	if (ch[pos] > 0) {
-		this->setUpstreamVelocity((K[pos] - this->getHead()) / (P[pos] * a[pos]));
-		this->setVelocity(this->getUpstreamVelocity());
-	}
-	else {
-		this->setDownstreamVelocity((this->getHead() - K[pos]) / (P[pos] * a[pos]));
-		this->setVelocity(this->getDownstreamVelocity());
-	}
-
-	this->computeCoefficients(settings, pos, el);
+	// head is kept
+	this->computeHeadBoundary(el, ch, pos, settings);
 }
 
 //	Mutators ==============================================================
@@ -158,8 +138,9 @@ ostream& Source::log(ostream& os) const
 Source& Source::operator= (const Node& n)
 {
 	Node::operator= (n);
-	if (const Source* r = down_cast<const Source> (&n))
-		discharge = r->discharge;
+	// reservoirs are sources as well
+	if (n.getType() == SOURCE || n.getType() == RESERVOIR)
+		discharge = static_cast<const Source&> (n).discharge;
 
 	return *this;
 }
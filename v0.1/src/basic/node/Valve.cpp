@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
@@ -27,8 +27,18 @@
 #include"Settings.h"
 #include"Constant.h"
 #include"Utility.h"
+#include"Profile.h"
 using namespace std;
 
+//=============================================================================
+//
+//	Constants
+
+static const double STATE_TOLERANCE {1e-9};
+	// states this close to fully open or closed
+	//  are snapped, changes summed over an event
+	//  carry roundoff
+
 //=============================================================================
 //
 //	Valve
@@ -63,12 +73,12 @@ void Valve::computeState(const double& period)
 		throw runtime_error("Valve::computeState(): negative period");
 
 	// compute and store new state
-	double change {rate/period};
+	double change {rate*period};
 
 	if (change > 0)
-		state+change > 1 ? state = 1 : state += change;
+		state+change > 1-STATE_TOLERANCE ? state = 1 : state += change;
 	else
-		(state+change < EPS) ? state = 0 : state += change;
+		(state+change < STATE_TOLERANCE) ? state = 0 : state += change;
 }
 
 double Valve::computeLoss() const
@@ -101,9 +111,6 @@ void Valve::computeTransient(const vector<pair<double, double>>& el,
 
 	this->computeTransientParameters(c, a, K, P, el, pos, ch, settings);
 
-	// compute new state
-	this->computeLoss();
-
 	// determine indices
 	double i_u, i_d;
 	if (ch[pos] > 0) {
@@ -116,8 +123,8 @@ void Valve::computeTransient(const vector<pair<double, double>>& el,
 	}
 
 	// constants
-	double delta_t {settings.timeStep};
-	double zeta {this->getLoss()};
+	double delta_t {this->getTimeStep()};
+	double zeta {this->computeLoss()};
 	double Z {this->getElevation()};
 	double h_v {settings.fluid.getVapourHead()};
 	double psi {settings.weightingFactor};
@@ -178,7 +185,11 @@ void Valve::computeTransient(const vector<pair<double, double>>& el,
 		Q_p = this->getArea() * this->getVelocity();
 
 		// Newton-Raphson
+		int iterations {0};
+
 		for (int i {0}; i < MAX_ITER; i++) {
+			iterations++;
+
 			// positive char
 			if (ch[pos] > 0) {
 				// compute root terms
@@ -248,6 +259,7 @@ void Valve::computeTransient(const vector<pair<double, double>>& el,
 			// reassign
 			Q_p = Q_p_new;
 		}
+		Profile::count(Profile::VALVE_ITERATIONS, iterations);
 
 		// compute velocity
 		this->setVelocity(Q_p / this->getArea());
@@ -327,7 +339,7 @@ void Valve::handleEvent(const Settings& settings)
 	// if exiting closing/opening period 
 	else if (this->getEventEnd() < settings.time
 		  && settings.timeStep > settings.time - this->getEventEnd()) {
-		period = settings.time - this->getEventEnd();
+		period = settings.timeStep - (settings.time - this->getEventEnd());
 	}
 	// if within closing/opening period
 	else {
@@ -0,0 +1,357 @@
+// Definitions for batched steady state computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<exception>
+#include<string>
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<chrono>
+#include<algorithm>
+#include<cmath>
+#include<cfloat>
+
+#include"batch.h"
+#include"ensemble.h"
+#include"steadyState.h"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Scenario.h"
+#include"Element.h"
+#include"Node.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Main function
+
+namespace Batch {
+
+void compute(const Network& net, const LoopDepot& depot)
+{
+	// read scenarios
+	ScenarioTable scenarios {"scenarios"};
+	scenarios.log(cout);
+
+	int size {scenarios.getSize()};
+	vector<Solution> solutions (size);
+
+	// span trees once
+	Steady::Trees trees;
+	Steady::span(net, trees);
+
+	// base network is the first warm start candidate
+	vector<double> scale {scales(net)};
+	Solution base;
+
+	base.scenario = 0;
+	base.key = key(net, scale);
+	store(net, base);
+
+	for (int i {0}; i < size; i++) {
+		Network copy {net};
+		scenarios.getScenario(i+1).apply(copy);
+		solutions[i].key = key(copy, scale);
+	}
+
+	// fix warm starts before solving, so they don't
+	//  depend on the order scenarios finish in
+	vector<int> order;
+	vector<int> warm;
+	plan(base, solutions, order, warm);
+
+	// solve scenarios on worker threads
+	atomic<int> next {0};
+	mutex guard;
+	condition_variable ready;
+	vector<bool> done (size, false);
+	vector<exception_ptr> errors (size);
+
+	auto worker = [&]() {
+		for (int k {next++}; k < size; k = next++) {
+			int i {order[k]};
+
+			try {
+				Solution& s {solutions[i]};
+
+				// apply scenario
+				Network copy {net};
+				scenarios.getScenario(i+1).apply(copy);
+				s.scenario = scenarios.getScenario(i+1).id;
+
+				// wait for warm start, it precedes in order
+				//  and is taken by an earlier worker
+				{
+					unique_lock<mutex> lock {guard};
+					ready.wait(lock, [&]() {
+						return warm[i] < 0 || done[warm[i]]; });
+				}
+
+				// a failed warm start falls back to the base
+				if (warm[i] < 0 || errors[warm[i]])
+					solve(copy, depot, trees, base, s);
+				else
+					solve(copy, depot, trees, solutions[warm[i]], s);
+				write(net, s);
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+
+			// failures release waiting scenarios too,
+			//  the first failure is reported
+			{
+				lock_guard<mutex> lock {guard};
+				done[i] = true;
+			}
+			ready.notify_all();
+		}
+	};
+
+	vector<thread> pool;
+	for (int i {0}; i < Ensemble::threadCount(net.settings, size); i++) {
+		pool.push_back(thread {worker});
+	}
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e)
+			rethrow_exception(e);
+	}
+
+	log(cout, solutions);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void solve(const Network& net, const LoopDepot& depot,
+		const Steady::Trees& trees, const Solution& warm, Solution& s)
+{
+	auto start = chrono::steady_clock::now();
+	Profile::Span span {"scenario"};
+
+	// loops are rebound to the copy
+	LoopDepot copyDepot {depot, net};
+
+	// initial guess from warm start
+	for (int i {0}; i < net.getElementQty(); i++) {
+		net.getElement(i+1)->setFlow(warm.flow[i]);
+	}
+
+	s.warmFrom = warm.scenario;
+	Steady::Status status {Steady::compute(net, copyDepot, trees, true,
+			1, NULL)};
+	s.iterations = status.iterations;
+	s.converged = status.converged;
+
+	store(net, s);
+
+	s.seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+}
+
+void write(const Network& net, const Solution& s)
+{
+	string file {"steady_"+to_string(s.scenario)+"_nodes.csv"};
+	ofstream ofs {file};
+	if (!ofs)
+		throw runtime_error("Batch::write(): "+file);
+
+	ofs << "node,head,pressure\n"
+		<< setprecision(9)
+		<< fixed;
+
+	for (unsigned i {0}; i < s.head.size(); i++) {
+		ofs << net.getNode(i+1)->getLabel() << ','
+			<< s.head[i] << ','
+			<< s.pressure[i] << '\n';
+	}
+
+	file = "steady_"+to_string(s.scenario)+"_elements.csv";
+	ofs.close();
+	ofs.open(file);
+	if (!ofs)
+		throw runtime_error("Batch::write(): "+file);
+
+	ofs << "element,flow\n";
+
+	for (unsigned i {0}; i < s.flow.size(); i++) {
+		ofs << net.getElement(i+1)->getLabel() << ','
+			<< s.flow[i] << '\n';
+	}
+}
+
+ostream& log(ostream& os, const vector<Solution>& solutions)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << "\nListing steady scenario results:\n\n";
+	os << "|   ID   |  Warm from  |  Iterations  |  Converged  |";
+	os << "  Wall time  |  Max head  |  Min pressure  |\n";
+	os << "|   [-]  |     [-]     |     [-]      |     [-]     |";
+	os << "     [s]     |    [m]     |      [Pa]      |\n\n";
+
+	for (const Solution& s : solutions) {
+		os << left
+		   << s_3
+		   << setw(5) << s.scenario
+		   << s_2
+		   << setw(11) << s.warmFrom
+		   << s_2
+		   << setw(12) << s.iterations
+		   << s_2
+		   << setw(11) << (s.converged ? "yes" : "no")
+		   << s_2
+		   << scientific
+		   << setprecision(3)
+		   << setw(11) << s.seconds
+		   << s_2
+		   << fixed
+		   << setw(10) << *max_element(s.head.begin(), s.head.end())
+		   << s_2
+		   << scientific
+		   << setw(14) << s.minPressure
+		   << "|\n";
+	}
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+vector<double> scales(const Network& net)
+	// scales[0] - largest nodal discharge
+	// scales[1] - largest fixed head
+{
+	vector<double> scale {DBL_MIN, DBL_MIN};
+	Node* n;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		n = net.getNode(i);
+
+		if (Source* s = Steady::recastToSource(n))
+			scale[0] = max(scale[0], abs(s->getDischarge()));
+		if (n->isFixed())
+			scale[1] = max(scale[1], abs(n->getHead()));
+	}
+
+	return scale;
+}
+
+vector<double> key(const Network& net, const vector<double>& scale)
+{
+	vector<double> k;
+	Node* n;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		n = net.getNode(i);
+
+		// heads at fixed nodes determine
+		//  their discharges
+		if (n->isFixed())
+			k.push_back(n->getHead() / scale[1]);
+		else if (Source* s = Steady::recastToSource(n))
+			k.push_back(s->getDischarge() / scale[0]);
+	}
+
+	return k;
+}
+
+void store(const Network& net, Solution& s)
+{
+	s.flow.resize(net.getElementQty());
+	s.head.resize(net.getNodeQty());
+	s.pressure.resize(net.getNodeQty());
+
+	for (int i {0}; i < net.getElementQty(); i++) {
+		s.flow[i] = net.getElement(i+1)->getFlow();
+	}
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		s.head[i] = net.getNode(i+1)->getHead();
+		s.pressure[i] = net.getNode(i+1)->getPressure();
+	}
+
+	// pressures at fixed heads are input
+	s.minPressure = DBL_MAX;
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (!net.getNode(i+1)->isFixed())
+			s.minPressure = min(s.minPressure, s.pressure[i]);
+	}
+}
+
+void plan(const Solution& base, const vector<Solution>& solutions,
+		vector<int>& order, vector<int>& warm)
+	// scenarios in order of distance from the base,
+	//  ties by position, each warm started from the
+	//  nearest of the base and those before it
+{
+	int size {int(solutions.size())};
+	vector<double> dist (size);
+
+	order.resize(size);
+	for (int i {0}; i < size; i++) {
+		order[i] = i;
+		dist[i] = distance(base.key, solutions[i].key);
+	}
+	stable_sort(order.begin(), order.end(),
+			[&](const int& a, const int& b) { return dist[a] < dist[b]; });
+
+	warm.assign(size, -1);
+	double best;
+	double d;
+
+	for (int k {0}; k < size; k++) {
+		best = dist[order[k]];
+
+		for (int j {0}; j < k; j++) {
+			d = distance(solutions[order[j]].key, solutions[order[k]].key);
+			if (d < best) {
+				best = d;
+				warm[order[k]] = order[j];
+			}
+		}
+	}
+}
+
+double distance(const vector<double>& a, const vector<double>& b)
+	// squared euclidean distance
+{
+	double dist {0};
+
+	for (unsigned j {0}; j < a.size(); j++) {
+		dist += pow(a[j] - b[j], 2);
+	}
+
+	return dist;
+}
+
+}
@@ -0,0 +1,102 @@
+// Declarations for batched steady state computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: batch.cpp
+
+#ifndef BATCH_H
+#define BATCH_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<vector>
+
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Scenario.h"
+#include"steadyState.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Batch {
+
+// solved steady state of a scenario
+struct Solution {
+	int scenario;
+		// id of scenario, 0 for the base network
+	int warmFrom;
+		// id of solution used as initial guess
+	int iterations;
+		// number of Hardy-Cross iterations
+	bool converged;
+		// check if Hardy-Cross iterations met
+		//  the tolerances
+	double seconds;						// [s]
+		// wall time of solve
+	std::vector<double> key;
+		// scaled nodal discharges and fixed heads
+		//  used to find the nearest solution
+	std::vector<double> flow;			// [m3s-1]
+		// flows through elements
+	std::vector<double> head;			// [m]
+		// heads at nodes
+	std::vector<double> pressure;		// [Pa]
+		// pressures at nodes
+	double minPressure;					// [Pa]
+		// minimum pressure at nodes without
+		//  a fixed head
+};
+
+// Main function
+
+void compute(const Network&, const LoopDepot&);
+	// solve the steady state for each scenario
+	//  in the 'scenarios' input file
+	// - network must hold a converged steady state
+	// - spanning trees of the topology are
+	//   computed once and shared
+	// - scenarios are solved in order of distance
+	//   from the base network, each warm started
+	//   from the nearest of the base and those
+	//   before it, results don't depend on the
+	//   number of threads
+
+// Tier 1 functions
+void solve(const Network&, const LoopDepot&, const Steady::Trees&,
+		const Solution&, Solution&);
+	// solve a scenario applied to a network copy
+	//  starting from flows of a previous solution
+void write(const Network&, const Solution&);
+	// write solution to steady_<id>_nodes.csv
+	//  and steady_<id>_elements.csv
+	// - rows are labelled with input ids
+std::ostream& log(std::ostream&, const std::vector<Solution>&);
+	// log output
+
+// Tier 2 functions
+std::vector<double> scales(const Network&);
+	// scales of discharges and heads
+std::vector<double> key(const Network&, const std::vector<double>&);
+	// scaled nodal discharges and fixed heads
+void store(const Network&, Solution&);
+	// store state of network
+void plan(const Solution&, const std::vector<Solution>&,
+		std::vector<int>&, std::vector<int>&);
+	// order of solving and warm start of each
+	//  solution by position, -1 for the base
+	// - input are the base and keys of solutions
+double distance(const std::vector<double>&, const std::vector<double>&);
+	// squared distance of keys
+
+}
+
+#endif
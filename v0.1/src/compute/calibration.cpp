@@ -0,0 +1,480 @@
+// Definitions for calibration computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<cmath>
+#include<climits>
+
+#include"calibration.h"
+#include"sensitivity.h"
+#include"steadyState.h"
+#include"ensemble.h"
+#include"Dense"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Observation.h"
+#include"Element.h"
+#include"Node.h"
+#include"Constant.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Constants
+
+static const int MAX_STEPS {50};
+	// largest number of Levenberg-Marquardt steps
+static const double TOLERANCE {1e-8};
+	// smallest accepted relative decrease of cost
+	//  and smallest relative step
+static const double DAMPING {1e-3};
+	// initial damping relative to the largest
+	//  diagonal entry of J * J^T
+static const double MAX_DAMPING {1e8};
+	// largest damping relative to the initial
+static const double MIN_ROUGHNESS {1e-7};		// [m]
+	// smallest calibrated roughness, smoother
+	//  than drawn tubing
+static const double MAX_ROUGHNESS {1e-2};		// [m]
+	// largest calibrated roughness, heavily
+	//  tuberculated pipes
+static const double DIAMETER_RANGE {2};
+	// largest factor between calibrated and
+	//  initial diameter, either way
+static const double DISCHARGE_RANGE {100};
+	// largest factor between calibrated and
+	//  initial discharge, either way
+
+//=============================================================================
+//
+//	Main function
+
+namespace Calibration {
+
+void compute(const Network& net, const LoopDepot& depot)
+{
+	// read observations
+	ObservationTable table {"observations"};
+	table.log(cout);
+
+	// calibrate a copy
+	Network copy {net};
+	LoopDepot copyDepot {depot, copy};
+
+	// span trees once, rooted at fixed heads
+	//  so changed discharges are drawn from them
+	Steady::Trees trees;
+	Steady::span(copy, copyDepot, trees);
+
+	// steps are serial, solves use all threads
+	const int threads {Ensemble::threadCount(copy.settings, INT_MAX)};
+
+	// observed heads
+	int size {table.getSize()};
+	const double scale {copy.settings.fluid.getDensity() * GRAVITY};
+	vector<int> nodes (size);
+	Eigen::VectorXd observed (size);
+	Eigen::VectorXd weight (size);
+
+	for (int i {0}; i < size; i++) {
+		const Observation& o {table.getObservation(i+1)};
+
+		nodes[i] = find(copy, o.id);
+		weight(i) = o.weight;
+
+		if (o.isPressure())
+			observed(i) = o.value / scale + copy.getNode(nodes[i])->getElevation();
+		else
+			observed(i) = o.value;
+	}
+
+	// sensitivities of the initial state
+	Sensitivity::Sensitivities sens;
+	Sensitivity::compute(copy, nodes, sens);
+	Sensitivity::write(copy, sens);
+
+	vector<Unknown> unknowns {select(copy)};
+	Eigen::VectorXd x {Eigen::VectorXd::Zero(unknowns.size())};
+
+	Eigen::VectorXd r {residual(copy, nodes, observed, weight)};
+	Eigen::MatrixXd J {jacobian(copy, sens, unknowns, weight)};
+
+	vector<Step> steps (1);
+	steps[0] = Step {0, 0.5 * r.squaredNorm(), 0, true, 0, true, 0};
+
+	// damping scaled to the problem
+	Eigen::MatrixXd JJ {J * J.transpose()};
+	const double mu_0 {DAMPING * max(JJ.diagonal().maxCoeff(), EPS)};
+	double mu {mu_0};
+
+	vector<double> flows (copy.getElementQty());
+	Eigen::MatrixXd free;
+		// Jacobian of parameters free to move
+	Eigen::VectorXd g;
+	Eigen::VectorXd dx;
+	Eigen::VectorXd trial;
+	double cost;
+
+	for (int i {1}; i <= MAX_STEPS && steps.back().cost > 0; i++) {
+		auto start = chrono::steady_clock::now();
+		Profile::Span span {"calibration"};
+
+		Step s {i, 0, mu, false, 0, true, 0};
+		Steady::Status status;
+
+		// parameters at a bound that descent J^T r
+		//  pushes past it are held
+		g = J.transpose() * r;
+		free = J;
+		for (unsigned j {0}; j < unknowns.size(); j++) {
+			if ((x(j) <= unknowns[j].lower && g(j) < 0)
+			 || (x(j) >= unknowns[j].upper && g(j) > 0))
+				free.col(j).setZero();
+		}
+
+		// (J^T J + mu I) dx = J^T r
+		//  =>  dx = J^T (J J^T + mu I)^-1 r
+		JJ = free * free.transpose();
+		JJ.diagonal().array() += mu;
+		dx = free.transpose() * JJ.ldlt().solve(r);
+
+		// stay within bounds
+		for (unsigned j {0}; j < unknowns.size(); j++) {
+			dx(j) = min(max(x(j) + dx(j), unknowns[j].lower),
+						unknowns[j].upper) - x(j);
+		}
+
+		// converged to a point
+		if (dx.norm() <= TOLERANCE * (x.norm() + TOLERANCE))
+			break;
+
+		// keep the state of the last accepted step
+		for (int j {0}; j < copy.getElementQty(); j++) {
+			flows[j] = copy.getElement(j+1)->getFlow();
+		}
+
+		apply(copy, unknowns, x + dx);
+		status = Steady::compute(copy, copyDepot, trees, true, threads, NULL);
+		s.iterations = status.iterations;
+		s.converged = status.converged;
+
+		trial = residual(copy, nodes, observed, weight);
+		cost = 0.5 * trial.squaredNorm();
+
+		// accept and relinearize, an unconverged
+		//  state is no base for a linearization
+		if (status.converged && cost < steps.back().cost) {
+			s.accepted = true;
+			s.cost = cost;
+
+			x += dx;
+			r = trial;
+			mu = max(mu / 10, mu_0 / MAX_DAMPING);
+
+			Sensitivity::compute(copy, nodes, sens);
+			J = jacobian(copy, sens, unknowns, weight);
+		}
+		// reject and restore
+		else {
+			s.cost = steps.back().cost;
+
+			apply(copy, unknowns, x);
+			for (int j {0}; j < copy.getElementQty(); j++) {
+				copy.getElement(j+1)->setFlow(flows[j]);
+			}
+			status = Steady::compute(copy, copyDepot, trees, true, threads,
+					NULL);
+			s.iterations += status.iterations;
+			s.converged = s.converged && status.converged;
+
+			mu *= 10;
+		}
+
+		s.seconds = chrono::duration<double>(
+					chrono::steady_clock::now() - start).count();
+
+		double decrease {(steps.back().cost - s.cost) / steps.back().cost};
+		steps.push_back(s);
+
+		// converged
+		if (s.accepted && decrease < TOLERANCE)
+			break;
+		// no descent left
+		if (mu > MAX_DAMPING * mu_0)
+			break;
+	}
+
+	write(copy, unknowns, steps);
+	log(cout, steps);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+vector<Unknown> select(const Network& net)
+{
+	vector<Unknown> unknowns {};
+	const string& calibrate {net.settings.calibrate};
+	Node* n;
+
+	if (calibrate == "roughness" || calibrate == "all") {
+		for (int i {1}; i <= net.getElementQty(); i++) {
+			// smooth elements keep zero roughness
+			if (net.getElement(i)->getRoughness() > 0)
+				unknowns.push_back(Unknown {Sensitivity::ROUGHNESS, i,
+						net.getElement(i)->getRoughness(), 0, 0});
+		}
+	}
+	if (calibrate == "demand" || calibrate == "all") {
+		for (int i {1}; i <= net.getNodeQty(); i++) {
+			// assign
+			n = net.getNode(i);
+
+			// sources with demand, discharges at
+			//  fixed heads are results
+			if (Source* s = down_cast<Source>(n)) {
+				if (!s->isFixed() && s->getDischarge() != 0)
+					unknowns.push_back(Unknown {Sensitivity::DISCHARGE, i,
+							s->getDischarge(), 0, 0});
+			}
+		}
+	}
+
+	if (unknowns.empty())
+		throw runtime_error("Calibration::select(): no parameters");
+
+	for (Unknown& u : unknowns) {
+		bound(u);
+	}
+
+	return unknowns;
+}
+
+Eigen::MatrixXd jacobian(const Network& net,
+		const Sensitivity::Sensitivities& sens,
+		const vector<Unknown>& unknowns, const Eigen::VectorXd& weight)
+	// p = p_0 * exp(x)  =>  dH/dx = dH/dp * p
+{
+	Eigen::MatrixXd J (sens.nodes.size(), unknowns.size());
+	const Eigen::MatrixXd* D;
+
+	for (unsigned i {0}; i < unknowns.size(); i++) {
+		const Unknown& u {unknowns[i]};
+
+		if (u.parameter == Sensitivity::ROUGHNESS)
+			D = &sens.roughness;
+		else if (u.parameter == Sensitivity::DIAMETER)
+			D = &sens.diameter;
+		else
+			D = &sens.discharge;
+
+		J.col(i) = weight.cwiseProduct(D->col(u.id-1)) * get(net, u);
+	}
+
+	return J;
+}
+
+Eigen::VectorXd residual(const Network& net, const vector<int>& nodes,
+		const Eigen::VectorXd& observed, const Eigen::VectorXd& weight)
+{
+	Eigen::VectorXd r (nodes.size());
+
+	for (unsigned i {0}; i < nodes.size(); i++) {
+		r(i) = weight(i) * (observed(i) - net.getNode(nodes[i])->getHead());
+	}
+
+	return r;
+}
+
+void write(const Network& net, const vector<Unknown>& unknowns,
+		const vector<Step>& steps)
+{
+	ofstream ofs {"calibrated.csv"};
+	if (!ofs)
+		throw runtime_error("Calibration::write(): calibrated.csv");
+
+	ofs << "parameter,id,initial,calibrated\n"
+		<< setprecision(9)
+		<< scientific;
+
+	for (const Unknown& u : unknowns) {
+		ofs << Sensitivity::parameterName(u.parameter) << ',';
+
+		if (u.parameter == Sensitivity::DISCHARGE)
+			ofs << net.getNode(u.id)->getLabel();
+		else
+			ofs << net.getElement(u.id)->getLabel();
+
+		ofs << ',' << u.initial
+			<< ',' << get(net, u) << '\n';
+	}
+
+	ofs.close();
+	ofs.open("calibration.csv");
+	if (!ofs)
+		throw runtime_error("Calibration::write(): calibration.csv");
+
+	ofs << "step,cost,damping,accepted,iterations,converged\n";
+
+	for (const Step& s : steps) {
+		ofs << s.iteration << ','
+			<< s.cost << ','
+			<< s.damping << ','
+			<< s.accepted << ','
+			<< s.iterations << ','
+			<< s.converged << '\n';
+	}
+}
+
+ostream& log(ostream& os, const vector<Step>& steps)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+	int total {0};
+
+	os << "\nListing calibration steps:\n\n";
+	os << "|  Step  |     Cost     |   Damping    |  Accepted  |";
+	os << "  Iterations  |  Converged  |  Wall time  |\n";
+	os << "|  [-]   |     [m2]     |     [m2]     |    [-]     |";
+	os << "     [-]      |     [-]     |     [s]     |\n\n";
+
+	for (const Step& s : steps) {
+		os << left
+		   << s_3
+		   << setw(5) << s.iteration
+		   << s_2
+		   << scientific
+		   << setprecision(3)
+		   << setw(12) << s.cost
+		   << s_2
+		   << setw(12) << s.damping
+		   << s_2
+		   << setw(10) << (s.accepted ? "yes" : "no")
+		   << s_2
+		   << setw(12) << s.iterations
+		   << s_2
+		   << setw(11) << (s.converged ? "yes" : "no")
+		   << s_2
+		   << setw(11) << s.seconds
+		   << "|\n";
+
+		total += s.iterations;
+	}
+
+	os << "\nTotal iterations:\t" << total << '\n';
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+int find(const Network& net, const int& label)
+{
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (net.getNode(i)->getLabel() != label)
+			continue;
+
+		// fixed heads are not fitted
+		if (net.getNode(i)->isFixed())
+			throw runtime_error("Calibration::find(): node "
+								+to_string(label)+" fixed");
+		return i;
+	}
+
+	throw runtime_error("Calibration::find(): node "
+						+to_string(label)+" missing");
+}
+
+void bound(Unknown& u)
+	// p = p_0 * exp(x), a bound is widened to
+	//  hold an initial value outside it
+{
+	double lower;
+	double upper;
+
+	switch (u.parameter) {
+		case Sensitivity::ROUGHNESS:
+			lower = MIN_ROUGHNESS / u.initial;
+			upper = MAX_ROUGHNESS / u.initial;
+			break;
+		case Sensitivity::DIAMETER:
+			lower = 1 / DIAMETER_RANGE;
+			upper = DIAMETER_RANGE;
+			break;
+		case Sensitivity::DISCHARGE:
+			lower = 1 / DISCHARGE_RANGE;
+			upper = DISCHARGE_RANGE;
+			break;
+		default:
+			throw runtime_error("Calibration::bound(): parameter");
+	}
+
+	u.lower = min(std::log(lower), 0.0);
+	u.upper = max(std::log(upper), 0.0);
+}
+
+double get(const Network& net, const Unknown& u)
+{
+	switch (u.parameter) {
+		case Sensitivity::ROUGHNESS:
+			return net.getElement(u.id)->getRoughness();
+		case Sensitivity::DIAMETER:
+			return net.getElement(u.id)->getDiameter();
+		case Sensitivity::DISCHARGE:
+			return down_cast<Source>(net.getNode(u.id))->getDischarge();
+		default:
+			throw runtime_error("Calibration::get(): parameter");
+	}
+}
+
+void set(const Network& net, const Unknown& u, const double& value)
+{
+	switch (u.parameter) {
+		case Sensitivity::ROUGHNESS:
+			net.getElement(u.id)->setRoughness(value);
+			break;
+		case Sensitivity::DIAMETER:
+			net.getElement(u.id)->setDiameter(value);
+			break;
+		case Sensitivity::DISCHARGE:
+			down_cast<Source>(net.getNode(u.id))->setDischarge(value);
+			break;
+		default:
+			throw runtime_error("Calibration::set(): parameter");
+	}
+}
+
+void apply(const Network& net, const vector<Unknown>& unknowns,
+		const Eigen::VectorXd& x)
+{
+	for (unsigned i {0}; i < unknowns.size(); i++) {
+		set(net, unknowns[i], unknowns[i].initial * exp(x(i)));
+	}
+
+	// fixed heads take changed discharges
+	Steady::balanceDischarge(net);
+}
+
+}
@@ -0,0 +1,125 @@
+// Declarations for calibration computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: calibration.cpp
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<vector>
+
+#include"Dense"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Observation.h"
+#include"sensitivity.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Calibration {
+
+// calibrated parameter of an element or node
+struct Unknown {
+	int parameter;
+		// Sensitivity::Parameter
+	int id;
+		// id of element or node
+	double initial;
+		// value before calibration
+	double lower;
+		// lowest scaled value x
+	double upper;
+		// highest scaled value x
+};
+
+// Levenberg-Marquardt step
+struct Step {
+	int iteration;
+		// number of step, 0 for the initial state
+	double cost;						// [m2]
+		// half the sum of squared weighted residuals
+	double damping;						// [m2]
+		// Levenberg-Marquardt damping
+	bool accepted;
+		// check if the step lowered the cost
+	int iterations;
+		// number of Hardy-Cross iterations
+	bool converged;
+		// check if Hardy-Cross iterations met
+		//  the tolerances
+	double seconds;						// [s]
+		// wall time of step
+};
+
+// Main function
+
+void compute(const Network&, const LoopDepot&);
+	// fit parameters to the heads and pressures
+	//  of the 'observations' input file
+	// - network must hold a converged steady state
+	// - parameters follow the calibrate setting,
+	//   roughness of all elements, discharges of
+	//   sources with demand or both
+	// - parameters are scaled as p = p_0 * exp(x),
+	//   they keep their sign and steps are relative
+	// - parameters stay within physical bounds of
+	//   their kind, those held at a bound take no
+	//   step
+	// - steps whose steady solve doesn't converge
+	//   are rejected
+	// - the Jacobian comes from adjoint sensitivities,
+	//   one linear solve per observation instead of
+	//   one steady solve per parameter
+	// - steps solve the damped normal equations in
+	//   the space of observations, so thousands of
+	//   parameters cost a small dense solve
+
+// Tier 1 functions
+std::vector<Unknown> select(const Network&);
+	// parameters of calibrate setting, bounded
+Eigen::MatrixXd jacobian(const Network&, const Sensitivity::Sensitivities&,
+		const std::vector<Unknown>&, const Eigen::VectorXd&);
+	// derivatives of weighted heads with respect to
+	//  scaled parameters, input are weights
+Eigen::VectorXd residual(const Network&, const std::vector<int>&,
+		const Eigen::VectorXd&, const Eigen::VectorXd&);
+	// weighted differences of observed and computed
+	//  heads, input are nodes, observed heads, weights
+void write(const Network&, const std::vector<Unknown>&,
+		const std::vector<Step>&);
+	// write parameters to calibrated.csv and
+	//  steps to calibration.csv
+	// - rows are labelled with input ids
+std::ostream& log(std::ostream&, const std::vector<Step>&);
+	// log output
+
+// Tier 2 functions
+int find(const Network&, const int&);
+	// id of observed node from input id
+	// - node must not have a fixed head
+void bound(Unknown&);
+	// set bounds of scaled value by kind of
+	//  parameter
+double get(const Network&, const Unknown&);
+	// get current value of parameter
+void set(const Network&, const Unknown&, const double&);
+	// set value of parameter
+void apply(const Network&, const std::vector<Unknown>&,
+		const Eigen::VectorXd&);
+	// set parameters from scaled values
+
+}
+
+#endif
@@ -0,0 +1,447 @@
+// Definitions for pipe criticality computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<exception>
+#include<string>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<chrono>
+#include<algorithm>
+#include<cmath>
+#include<cfloat>
+
+#include"criticality.h"
+#include"ensemble.h"
+#include"steadyState.h"
+#include"Dense"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Element.h"
+#include"Loop.h"
+#include"Node.h"
+#include"Constant.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Constants
+
+static const double FLOW_FLOOR {1e-3};
+	// smallest flow in linearization relative to largest,
+	//  keeps conductances of stagnant elements finite
+
+//=============================================================================
+//
+//	Main function
+
+namespace Criticality {
+
+void compute(Network& net, const LoopDepot& depot)
+{
+	int size {net.getElementQty()};
+	vector<Closure> closures (size);
+
+	// factorize once
+	Linear linear;
+	factorize(net, linear);
+
+	// base pressures
+	vector<double> base (net.getNodeQty());
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		base[i] = net.getNode(i+1)->getPressure();
+	}
+
+	// solve closures on worker threads
+	atomic<int> next {0};
+	vector<exception_ptr> errors (size);
+
+	auto worker = [&]() {
+		for (int i {next++}; i < size; i = next++) {
+			try {
+				// close on a copy
+				Network copy {net};
+
+				closures[i].element = i+1;
+				solve(copy, depot, linear, base, closures[i]);
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+		}
+	};
+
+	vector<thread> pool;
+	for (int i {0}; i < Ensemble::threadCount(net.settings, size); i++) {
+		pool.push_back(thread {worker});
+	}
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e)
+			rethrow_exception(e);
+	}
+
+	rank(closures);
+	write(net, closures);
+	log(cout, net, closures);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void factorize(Network& net, Linear& linear)
+	/*
+	 * h = r * q * |q|  =>  g = dq/dh = 1 / (2 * r * |q|)
+	 *
+	 * L = sum of g * a * a^T over elements,
+	 *  a = start - end restricted to free nodes
+	 */
+{
+	// rows of free nodes
+	int rows {0};
+	linear.row.assign(net.getNodeQty(), -1);
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (!net.getNode(i+1)->isFixed())
+			linear.row[i] = rows++;
+	}
+
+	// floor of linearized flows
+	double floor {0};
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		floor = max(floor, abs(net.getElement(i)->getFlow()));
+	}
+	floor = floor > 0 ? FLOW_FLOOR * floor : FLOW_FLOOR;
+
+	Eigen::MatrixXd L {Eigen::MatrixXd::Zero(rows, rows)};
+	linear.conductance.resize(net.getElementQty());
+	Element* e;
+	double q;
+	double g;
+	int s;
+	int t;
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		// assign
+		e = net.getElement(i);
+		q = e->getFlow();
+
+		// stagnant elements have no friction,
+		//  linearize at the floor instead
+		if (abs(q) < floor)
+			e->setFlow(floor);
+		g = 1 / (2 * e->computeHeadLossC(net.settings.fluid)
+				   * abs(e->getFlow()));
+		e->setFlow(q);
+
+		s = linear.row[e->getStart().getId()-1];
+		t = linear.row[e->getEnd().getId()-1];
+
+		linear.conductance[i-1] = g;
+
+		// stamp
+		if (s >= 0)
+			L(s, s) += g;
+		if (t >= 0)
+			L(t, t) += g;
+		if (s >= 0 && t >= 0) {
+			L(s, t) -= g;
+			L(t, s) -= g;
+		}
+	}
+
+	linear.factor.compute(L);
+	if (linear.factor.info() != Eigen::Success)
+		throw runtime_error("Criticality::factorize(): singular");
+}
+
+void solve(Network& net, const LoopDepot& depot, const Linear& linear,
+		const vector<double>& base, Closure& c)
+{
+	auto start = chrono::steady_clock::now();
+	Profile::Span span {"closure"};
+
+	c.isolated = isolated(net, c.element);
+	c.iterations = 0;
+	c.converged = false;
+	c.estimate = 0;
+	c.deficit = 0;
+	c.node = 0;
+	c.minPressure = DBL_MAX;
+
+	// no steady state for nodes without fixed head
+	if (c.isolated > 0) {
+		c.seconds = chrono::duration<double>(
+					chrono::steady_clock::now() - start).count();
+		return;
+	}
+
+	// warm start from the linear update,
+	//  satisfies continuity at free nodes
+	vector<double> dh {update(net, linear, c.element)};
+	const double scale {net.settings.fluid.getDensity() * GRAVITY};
+	Element* e;
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		// assign
+		e = net.getElement(i);
+
+		if (i == c.element)
+			e->setFlow(0);
+		else
+			e->setFlow(e->getFlow() + linear.conductance[i-1]
+					 * (dh[e->getStart().getId()-1] - dh[e->getEnd().getId()-1]));
+	}
+	for (double h : dh) {
+		c.estimate = max(c.estimate, -h * scale);
+	}
+
+	// loops are rebound to the copy and updated
+	LoopDepot copyDepot {depot, net};
+	copyDepot.close(net, c.element);
+
+	Steady::Trees trees;
+	Steady::span(net, copyDepot, trees);
+	Steady::Status status {Steady::compute(net, copyDepot, trees, true,
+			1, NULL)};
+	c.iterations = status.iterations;
+	c.converged = status.converged;
+
+	// largest drop, pressures at fixed heads are input
+	double p;
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		p = net.getNode(i)->getPressure();
+		if (!net.getNode(i)->isFixed())
+			c.minPressure = min(c.minPressure, p);
+
+		if (c.node == 0 || base[i-1] - p > c.deficit) {
+			c.deficit = base[i-1] - p;
+			c.node = i;
+		}
+	}
+
+	c.seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+}
+
+void write(const Network& net, const vector<Closure>& closures)
+{
+	ofstream ofs {"criticality.csv"};
+	if (!ofs)
+		throw runtime_error("Criticality::write(): criticality.csv");
+
+	ofs << "rank,element,isolated,iterations,converged,estimate,deficit,"
+		<< "node,min_pressure\n"
+		<< setprecision(9)
+		<< fixed;
+
+	for (unsigned i {0}; i < closures.size(); i++) {
+		const Closure& c {closures[i]};
+
+		ofs << i+1 << ','
+			<< net.getElement(c.element)->getLabel() << ','
+			<< c.isolated << ','
+			<< c.iterations << ',';
+
+		// isolating closures have no steady state
+		if (c.isolated > 0) {
+			ofs << ",,,,\n";
+			continue;
+		}
+
+		ofs << c.converged << ','
+			<< c.estimate << ','
+			<< c.deficit << ','
+			<< net.getNode(c.node)->getLabel() << ',';
+
+		// all nodes may have fixed heads
+		if (c.minPressure < DBL_MAX)
+			ofs << c.minPressure;
+		ofs << '\n';
+	}
+}
+
+ostream& log(ostream& os, const Network& net, const vector<Closure>& closures)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << "\nListing closures by criticality:\n\n";
+	os << "|  Rank  |  Element  |  Isolated  |  Iterations  |  Converged  |";
+	os << "   Estimate   |    Deficit     |   Node   |  Min pressure  |";
+	os << "  Wall time  |\n";
+	os << "|  [-]   |    [-]    |    [-]     |     [-]      |     [-]     |";
+	os << "     [Pa]     |      [Pa]      |   [-]    |      [Pa]      |";
+	os << "     [s]     |\n\n";
+
+	for (unsigned i {0}; i < closures.size(); i++) {
+		const Closure& c {closures[i]};
+
+		os << left
+		   << s_3
+		   << setw(5) << i+1
+		   << s_2
+		   << setw(9) << net.getElement(c.element)->getLabel()
+		   << s_2
+		   << setw(10) << c.isolated
+		   << s_2
+		   << setw(12) << c.iterations
+		   << s_2
+		   << scientific
+		   << setprecision(3);
+
+		if (c.isolated > 0) {
+			os << setw(11) << '-'
+			   << s_2
+			   << setw(12) << '-'
+			   << s_2
+			   << setw(14) << '-'
+			   << s_2
+			   << setw(8) << '-'
+			   << s_2
+			   << setw(14) << '-';
+		}
+		else {
+			os << setw(11) << (c.converged ? "yes" : "no")
+			   << s_2
+			   << setw(12) << c.estimate
+			   << s_2
+			   << setw(14) << c.deficit
+			   << s_2
+			   << setw(8) << net.getNode(c.node)->getLabel()
+			   << s_2;
+			if (c.minPressure < DBL_MAX)
+				os << setw(14) << c.minPressure;
+			else
+				os << setw(14) << '-';
+		}
+
+		os << s_2
+		   << setw(11) << c.seconds
+		   << "|\n";
+	}
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+int isolated(const Network& net, const int& id)
+	// breadth first from fixed heads
+{
+	vector<bool> visited (net.getNodeQty(), false);
+	vector<int> queue {};
+	Loop* l;
+	Element* e;
+	int m;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (net.getNode(i)->isFixed()) {
+			visited[i-1] = true;
+			queue.push_back(i);
+		}
+	}
+
+	for (unsigned i {0}; i < queue.size(); i++) {
+		l = net.getNode(queue[i])->links;
+
+		for (int j {1}; j <= l->getSize(); j++) {
+			// assign
+			e = l->getElement(j);
+			if (e->getId() == id)
+				continue;
+
+			m = e->getStart().getId();
+			if (m == queue[i])
+				m = e->getEnd().getId();
+
+			if (!visited[m-1]) {
+				visited[m-1] = true;
+				queue.push_back(m);
+			}
+		}
+	}
+
+	return net.getNodeQty() - int(queue.size());
+}
+
+vector<double> update(const Network& net, const Linear& linear, const int& id)
+	/*
+	 * closing removes the flow q of the element from
+	 *  continuity and g * a * a^T from L:
+	 *
+	 * (L - g * a * a^T) dH = q * a
+	 *
+	 * z = L^-1 a  =>  dH = q * z / (1 - g * a^T z)
+	 */
+{
+	vector<double> dh (net.getNodeQty(), 0);
+	Element* e {net.getElement(id)};
+	int s {linear.row[e->getStart().getId()-1]};
+	int t {linear.row[e->getEnd().getId()-1]};
+
+	// between fixed heads
+	if (s < 0 && t < 0)
+		return dh;
+
+	Eigen::VectorXd a {Eigen::VectorXd::Zero(linear.factor.rows())};
+	if (s >= 0)
+		a(s) = 1;
+	if (t >= 0)
+		a(t) = -1;
+
+	Eigen::VectorXd z {linear.factor.solve(a)};
+	double g {linear.conductance[id-1]};
+	double factor {e->getFlow() / (1 - g * a.dot(z))};
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (linear.row[i] >= 0)
+			dh[i] = factor * z(linear.row[i]);
+	}
+
+	return dh;
+}
+
+void rank(vector<Closure>& closures)
+{
+	// deficits of unconverged solves are not comparable,
+	//  these closures are ranked by the linear estimate
+	stable_sort(closures.begin(), closures.end(),
+		[](const Closure& a, const Closure& b) {
+			if (a.isolated != b.isolated)
+				return a.isolated > b.isolated;
+			if (a.isolated > 0)
+				return false;
+			if (a.converged != b.converged)
+				return !a.converged;
+			if (!a.converged)
+				return a.estimate > b.estimate;
+			return a.deficit > b.deficit;
+		});
+}
+
+}
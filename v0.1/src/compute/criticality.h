@@ -0,0 +1,111 @@
+// Declarations for pipe criticality computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: criticality.cpp
+
+#ifndef CRITICALITY_H
+#define CRITICALITY_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<vector>
+
+#include"Dense"
+#include"Network.h"
+#include"LoopDepot.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Criticality {
+
+// nodal system of the base steady state linearized
+//  in heads, dq = g * (dH_start - dH_end)
+struct Linear {
+	std::vector<int> row;
+		// row of node by id-1, -1 for fixed heads
+	std::vector<double> conductance;	// [m2s-1]
+		// dq/dH of elements by id-1
+	Eigen::LLT<Eigen::MatrixXd> factor;
+		// Cholesky factor of the conductance
+		//  weighted Laplacian of free nodes
+};
+
+// steady state with an element closed
+struct Closure {
+	int element;
+		// id of closed element
+	int isolated;
+		// number of nodes cut off from fixed heads
+	int iterations;
+		// number of Hardy-Cross iterations
+	bool converged;
+		// check if Hardy-Cross iterations met
+		//  the tolerances
+	double seconds;						// [s]
+		// wall time of solve
+	double estimate;					// [Pa]
+		// largest pressure drop of the linear update
+	double deficit;						// [Pa]
+		// largest pressure drop
+	int node;
+		// id of node with largest drop, 0 if isolating
+	double minPressure;					// [Pa]
+		// lowest pressure
+};
+
+// Main function
+
+void compute(Network&, const LoopDepot&);
+	// solve the steady state with each element
+	//  closed in turn and rank the closures
+	// - network must hold a converged steady state
+	// - the linearized system is factorized once,
+	//   a closure removes one element from it, a
+	//   rank one update of the factor gives heads
+	//   and flows used as warm start
+	// - loops are updated by closing the element
+	//   instead of searching them again
+	// - closures isolating nodes are not solved
+
+// Tier 1 functions
+void factorize(Network&, Linear&);
+	// linearize and factorize the base state
+	// - flows of stagnant elements are raised
+	//   to the floor while linearized, then
+	//   restored
+void solve(Network&, const LoopDepot&, const Linear&,
+		const std::vector<double>&, Closure&);
+	// solve a closure applied to a network copy
+	// - input are base pressures by node id-1
+void write(const Network&, const std::vector<Closure>&);
+	// write ranked closures to criticality.csv
+	// - rows are labelled with input ids
+std::ostream& log(std::ostream&, const Network&,
+		const std::vector<Closure>&);
+	// log output
+
+// Tier 2 functions
+int isolated(const Network&, const int&);
+	// number of nodes cut off from fixed heads
+	//  by closing element, input is id
+std::vector<double> update(const Network&, const Linear&, const int&);
+	// head changes at nodes by id-1 after closing
+	//  element, Sherman-Morrison update of the factor
+	// - input is id of element
+void rank(std::vector<Closure>&);
+	// isolating closures first, then unconverged
+	//  closures by estimate, then by deficit
+
+}
+
+#endif
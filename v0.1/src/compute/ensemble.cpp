@@ -0,0 +1,246 @@
+// Definitions for ensemble computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<exception>
+#include<string>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<chrono>
+#include<algorithm>
+#include<cfloat>
+
+#include"ensemble.h"
+#include"steadyState.h"
+#include"transientState.h"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Scenario.h"
+#include"Element.h"
+#include"Node.h"
+#include"Settings.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Main function
+
+namespace Ensemble {
+
+void compute(const Network& net, const LoopDepot& depot)
+{
+	// read scenarios
+	ScenarioTable scenarios {"scenarios"};
+	scenarios.log(cout);
+
+	int size {scenarios.getSize()};
+	vector<Summary> summaries (size);
+
+	// run scenarios on worker threads
+	atomic<int> next {0};
+	vector<exception_ptr> errors (size);
+
+	auto worker = [&]() {
+		for (int i {next++}; i < size; i = next++) {
+			try {
+				run(net, depot, scenarios.getScenario(i+1), summaries[i]);
+				write(net, summaries[i]);
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+		}
+	};
+
+	vector<thread> pool;
+	for (int i {0}; i < threadCount(net.settings, size); i++) {
+		pool.push_back(thread {worker});
+	}
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e)
+			rethrow_exception(e);
+	}
+
+	log(cout, summaries);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void run(const Network& net, const LoopDepot& depot, const Scenario& scenario,
+		 Summary& summary)
+{
+	auto start = chrono::steady_clock::now();
+	Profile::Span span {"scenario"};
+
+	// copy mutable state
+	Network copy {net};
+	scenario.apply(copy);
+
+	// recompute steady state if needed
+	summary.converged = true;
+
+	if (scenario.changesSteady()) {
+		LoopDepot copyDepot {depot, copy};
+		summary.converged = Steady::compute(copy, copyDepot, 1, NULL).converged;
+	}
+
+	summary.scenario = scenario.id;
+	simulate(copy, summary);
+
+	summary.seconds = chrono::duration<double>(
+					  chrono::steady_clock::now() - start).count();
+}
+
+void simulate(Network& net, Summary& summary)
+{
+	// discretize network
+	net.discretize();
+
+	// initialize extremes
+	int size {net.getElementQty()};
+
+	summary.maxHead.assign(size, -DBL_MAX);
+	summary.minHead.assign(size, DBL_MAX);
+	summary.maxPressure.assign(size, -DBL_MAX);
+	summary.minPressure.assign(size, DBL_MAX);
+	record(net, summary);
+
+	// symulate
+	int counter {0};
+
+	while (net.settings.time < net.settings.symTime) {
+		// compute
+		Transient::step(net, counter);
+
+		// store extremes
+		record(net, summary);
+
+		// update
+		Transient::update(net, counter);
+
+		// increment
+		counter++;
+	}
+
+	summary.steps = counter;
+}
+
+void write(const Network& net, const Summary& summary)
+{
+	string file {"scenario_"+to_string(summary.scenario)+".csv"};
+	ofstream ofs {file};
+	if (!ofs)
+		throw runtime_error("Ensemble::write(): "+file);
+
+	ofs << "element,maxHead,minHead,maxPressure,minPressure\n"
+		<< setprecision(9)
+		<< fixed;
+
+	for (unsigned i {0}; i < summary.maxHead.size(); i++) {
+		ofs << net.getElement(i+1)->getLabel() << ','
+			<< summary.maxHead[i] << ','
+			<< summary.minHead[i] << ','
+			<< summary.maxPressure[i] << ','
+			<< summary.minPressure[i] << '\n';
+	}
+}
+
+ostream& log(ostream& os, const vector<Summary>& summaries)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << "\nListing scenario results:\n\n";
+	os << "|   ID   |  Steps  |  Converged  |  Wall time  |  Max head  |";
+	os << "  Min head  |  Min pressure  |\n";
+	os << "|   [-]  |   [-]   |     [-]     |     [s]     |    [m]     |";
+	os << "    [m]     |      [Pa]      |\n\n";
+
+	for (const Summary& s : summaries) {
+		os << left
+		   << s_3
+		   << setw(5) << s.scenario
+		   << s_2
+		   << setw(7) << s.steps
+		   << s_2
+		   << setw(11) << (s.converged ? "yes" : "no")
+		   << s_2
+		   << scientific
+		   << setprecision(3)
+		   << setw(11) << s.seconds
+		   << s_2
+		   << fixed
+		   << setw(10) << *max_element(s.maxHead.begin(), s.maxHead.end())
+		   << s_2
+		   << setw(10) << *min_element(s.minHead.begin(), s.minHead.end())
+		   << s_2
+		   << scientific
+		   << setw(14) << *min_element(s.minPressure.begin(), s.minPressure.end())
+		   << "|\n";
+	}
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+int threadCount(const Settings& settings, const int& tasks)
+{
+	int count {settings.threads};
+
+	if (count == 0)
+		count = thread::hardware_concurrency();
+	if (count < 1)
+		count = 1;
+
+	return min(count, tasks);
+}
+
+void record(const Network& net, Summary& summary)
+{
+	Element* e;
+	Node* n;
+
+	for (int i {0}; i < net.getElementQty(); i++) {
+		// assign
+		e = net.getElement(i+1);
+
+		for (int j {0}; j < e->getMeshSize(); j++) {
+			// assign
+			n = e->getMeshNode(j);
+
+			summary.maxHead[i] = max(summary.maxHead[i], n->getHead());
+			summary.minHead[i] = min(summary.minHead[i], n->getHead());
+			summary.maxPressure[i] = max(summary.maxPressure[i], n->getPressure());
+			summary.minPressure[i] = min(summary.minPressure[i], n->getPressure());
+		}
+	}
+}
+
+}
@@ -0,0 +1,83 @@
+// Declarations for ensemble computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: ensemble.cpp
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<vector>
+
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Scenario.h"
+#include"Settings.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Ensemble {
+
+// summary of a scenario run
+struct Summary {
+	int scenario;
+		// id of scenario
+	int steps;
+		// number of time steps computed
+	bool converged;
+		// check if Hardy-Cross iterations of a
+		//  recomputed steady state met the tolerances
+	double seconds;						// [s]
+		// wall time of run
+	std::vector<double> maxHead;		// [m]
+		// maximum head per element
+	std::vector<double> minHead;		// [m]
+		// minimum head per element
+	std::vector<double> maxPressure;	// [Pa]
+		// maximum pressure per element
+	std::vector<double> minPressure;	// [Pa]
+		// minimum pressure per element
+};
+
+// Main function
+
+void compute(const Network&, const LoopDepot&);
+	// run a transient simulation for each scenario
+	//  in the 'scenarios' input file
+	// - network must hold a converged steady state
+	// - network and depot are only read, each
+	//   scenario runs on its own copy
+
+// Tier 1 functions
+void run(const Network&, const LoopDepot&, const Scenario&, Summary&);
+	// run a single scenario
+void simulate(Network&, Summary&);
+	// transient simulation recording
+	//  extreme values
+void write(const Network&, const Summary&);
+	// write summary to scenario_<id>.csv
+	// - rows are labelled with input ids
+std::ostream& log(std::ostream&, const std::vector<Summary>&);
+	// log output
+
+// Tier 2 functions
+int threadCount(const Settings&, const int&);
+	// number of worker threads for
+	//  a given number of tasks
+void record(const Network&, Summary&);
+	// update extreme values from mesh
+
+}
+
+#endif
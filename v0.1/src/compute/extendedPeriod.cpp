@@ -0,0 +1,258 @@
+// Definitions for extended period computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<algorithm>
+#include<cfloat>
+#include<climits>
+
+#include"extendedPeriod.h"
+#include"steadyState.h"
+#include"ensemble.h"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Pattern.h"
+#include"Node.h"
+#include"Utility.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Main function
+
+namespace Extended {
+
+void compute(const Network& net, const LoopDepot& depot)
+{
+	// read pattern
+	Pattern pattern {"pattern"};
+	pattern.log(cout);
+
+	// span trees once
+	Steady::Trees trees;
+	Steady::span(net, trees);
+
+	// multipliers scale the input discharges
+	vector<double> base {baseDischarge(net)};
+	vector<Period> periods;
+
+	ofstream ofs {"period.csv"};
+	if (!ofs)
+		throw runtime_error("Extended::compute(): period.csv");
+	writeHeader(ofs, net);
+
+	for (int i {1}; i <= pattern.getPeriods(); i++) {
+		// solve
+		periods.push_back(solve(net, depot, trees, base, pattern, i));
+		write(ofs, net, periods.back());
+
+		// fill and drain reservoirs
+		integrate(net, pattern.getStep());
+	}
+
+	log(cout, periods);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+Period solve(const Network& net, const LoopDepot& depot,
+		const Steady::Trees& trees, const vector<double>& base,
+		const Pattern& pattern, const int& i)
+	// i = period
+{
+	auto start = chrono::steady_clock::now();
+	Profile::Span span {"period"};
+
+	Period p;
+	p.period = i;
+	p.time = (i-1) * pattern.getStep();
+	p.multiplier = pattern.getMultiplier(i);
+
+	// apply demand
+	Node* n;
+
+	for (int j {0}; j < net.getNodeQty(); j++) {
+		// assign
+		n = net.getNode(j+1);
+
+		if (Source* s = down_cast<Source>(n)) {
+			if (!s->isFixed())
+				s->setDischarge(base[j] * p.multiplier);
+		}
+	}
+	Steady::balanceDischarge(net);
+
+	// warm started steady state, periods are
+	//  serial and solves use all threads
+	Steady::Status status {Steady::compute(net, depot, trees, true,
+			Ensemble::threadCount(net.settings, INT_MAX), NULL)};
+	p.iterations = status.iterations;
+	p.converged = status.converged;
+
+	// store, pressures at fixed heads are input
+	p.minPressure = DBL_MAX;
+
+	for (int j {1}; j <= net.getNodeQty(); j++) {
+		if (!net.getNode(j)->isFixed())
+			p.minPressure = min(p.minPressure, net.getNode(j)->getPressure());
+	}
+
+	p.seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+
+	return p;
+}
+
+void integrate(const Network& net, const double& step)
+	// explicit Euler step of
+	//  dLevel/dt = -discharge / area
+{
+	Reservoir* r;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		r = down_cast<Reservoir>(net.getNode(i));
+
+		// skip constant level
+		if (!r || r->getArea() <= 0)
+			continue;
+
+		// positive discharge leaves the reservoir
+		r->setLevel(r->getLevel() - r->getDischarge() * step / r->getArea());
+
+		if (r->getLevel() < 0)
+			throw runtime_error("Extended::integrate(): reservoir "
+								+to_string(r->getLabel())+" empty");
+
+		// fixed head follows the free surface
+		r->computeHead(net.settings.fluid);
+	}
+}
+
+void write(ofstream& ofs, const Network& net, const Period& p)
+{
+	ofs << p.period << ','
+		<< setprecision(9)
+		<< fixed
+		<< p.time << ','
+		<< p.multiplier << ','
+		<< p.iterations << ','
+		<< p.converged;
+
+	for (Reservoir* r : reservoirs(net)) {
+		ofs << ',' << r->getLevel()
+			<< ',' << r->getDischarge();
+	}
+	ofs << '\n';
+}
+
+ostream& log(ostream& os, const vector<Period>& periods)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+	int total {0};
+
+	os << "\nListing periods:\n\n";
+	os << "|  Period  |    Time    |  Multiplier  |  Iterations  |";
+	os << "  Converged  |  Wall time  |  Min pressure  |\n";
+	os << "|   [-]    |    [s]     |     [-]      |     [-]      |";
+	os << "     [-]     |     [s]     |      [Pa]      |\n\n";
+
+	for (const Period& p : periods) {
+		os << left
+		   << s_3
+		   << setw(7) << p.period
+		   << s_2
+		   << fixed
+		   << setprecision(0)
+		   << setw(10) << p.time
+		   << s_2
+		   << setprecision(3)
+		   << setw(12) << p.multiplier
+		   << s_2
+		   << setw(12) << p.iterations
+		   << s_2
+		   << setw(11) << (p.converged ? "yes" : "no")
+		   << s_2
+		   << scientific
+		   << setw(11) << p.seconds
+		   << s_2
+		   << setw(14) << p.minPressure
+		   << "|\n";
+
+		total += p.iterations;
+	}
+
+	os << "\nTotal iterations:\t" << total << '\n';
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+vector<double> baseDischarge(const Network& net)
+{
+	vector<double> base (net.getNodeQty(), 0);
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (Source* s = down_cast<Source>(net.getNode(i+1))) {
+			if (!s->isFixed())
+				base[i] = s->getDischarge();
+		}
+	}
+
+	return base;
+}
+
+void writeHeader(ofstream& ofs, const Network& net)
+{
+	ofs << "period,time,multiplier,iterations,converged";
+
+	for (Reservoir* r : reservoirs(net)) {
+		ofs << ",level_" << r->getLabel()
+			<< ",discharge_" << r->getLabel();
+	}
+	ofs << '\n';
+}
+
+vector<Reservoir*> reservoirs(const Network& net)
+{
+	vector<Reservoir*> list {};
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (Reservoir* r = down_cast<Reservoir>(net.getNode(i)))
+			list.push_back(r);
+	}
+
+	// columns follow input ids
+	sort(list.begin(), list.end(),
+		 [](const Reservoir* a, const Reservoir* b)
+		 { return a->getLabel() < b->getLabel(); });
+
+	return list;
+}
+
+}
@@ -0,0 +1,86 @@
+// Declarations for extended period computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: extendedPeriod.cpp
+
+#ifndef EXTENDED_PERIOD_H
+#define EXTENDED_PERIOD_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<fstream>
+#include<vector>
+
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Pattern.h"
+#include"steadyState.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Extended {
+
+// result of a single period
+struct Period {
+	int period;
+		// number of period
+	double time;						// [s]
+		// start of period
+	double multiplier;
+		// demand multiplier
+	int iterations;
+		// number of Hardy-Cross iterations
+	bool converged;
+		// check if Hardy-Cross iterations met
+		//  the tolerances
+	double seconds;						// [s]
+		// wall time of steady solve
+	double minPressure;					// [Pa]
+		// minimum pressure at nodes without
+		//  a fixed head
+};
+
+// Main function
+
+void compute(const Network&, const LoopDepot&);
+	// sequence of steady states following the
+	//  'pattern' input file
+	// - network must hold a converged steady state
+	// - each period is warm started from the
+	//   flows of the previous one
+	// - levels of reservoirs with a surface area
+	//   are integrated between periods
+	// - network holds the last period on return
+
+// Tier 1 functions
+Period solve(const Network&, const LoopDepot&, const Steady::Trees&,
+		const std::vector<double>&, const Pattern&, const int&);
+	// solve the steady state of a period
+void integrate(const Network&, const double&);
+	// update reservoir levels over a period
+void write(std::ofstream&, const Network&, const Period&);
+	// write period to period.csv
+std::ostream& log(std::ostream&, const std::vector<Period>&);
+	// log output
+
+// Tier 2 functions
+std::vector<double> baseDischarge(const Network&);
+	// discharges at sources without fixed head
+void writeHeader(std::ofstream&, const Network&);
+	// write header of period.csv
+std::vector<Reservoir*> reservoirs(const Network&);
+	// reservoirs in order of input ids
+
+}
+
+#endif
@@ -0,0 +1,371 @@
+// Definitions for fire flow computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<exception>
+#include<string>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<chrono>
+#include<algorithm>
+#include<cmath>
+#include<cfloat>
+
+#include"fireflow.h"
+#include"ensemble.h"
+#include"steadyState.h"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Hydrant.h"
+#include"Node.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Constants
+
+static const double TOLERANCE {1e-4};
+	// accepted pressure surplus of a search
+	//  relative to the surplus without fire flow
+static const int MAX_SOLVES {30};
+	// largest number of steady solves of a search
+static const double MIN_GUESS {1e-3};	// [m3s-1]
+	// initial fire flow in networks without demand
+
+//=============================================================================
+//
+//	Main function
+
+namespace FireFlow {
+
+void compute(const Network& net, const LoopDepot& depot)
+{
+	// read hydrants
+	HydrantTable hydrants {"hydrants"};
+	hydrants.log(cout);
+
+	int size {hydrants.getSize()};
+	vector<Result> results (size);
+
+	// span trees once, rooted at fixed heads
+	//  so fire flows are drawn from them
+	Steady::Trees trees;
+	Steady::span(net, depot, trees);
+
+	// solve hydrants on worker threads
+	atomic<int> next {0};
+	vector<exception_ptr> errors (size);
+
+	auto worker = [&]() {
+		for (int i {next++}; i < size; i = next++) {
+			try {
+				// draw on a copy
+				Network copy {net};
+				const Hydrant& h {hydrants.getHydrant(i+1)};
+
+				results[i].node = find(copy, h.id);
+				solve(copy, depot, trees, h, results[i]);
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+		}
+	};
+
+	vector<thread> pool;
+	for (int i {0}; i < Ensemble::threadCount(net.settings, size); i++) {
+		pool.push_back(thread {worker});
+	}
+	for (thread& t : pool) {
+		t.join();
+	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e)
+			rethrow_exception(e);
+	}
+
+	write(net, results);
+	log(cout, net, results);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void solve(const Network& net, const LoopDepot& depot,
+		const Steady::Trees& trees, const Hydrant& h, Result& r)
+	/*
+	 * head losses grow with q * |q|, so the surplus m
+	 * of pressure over the targets is close to linear
+	 * in s = q^2; secant steps on s from the base state
+	 * (s = 0) find m(s) = 0
+	 */
+{
+	auto start = chrono::steady_clock::now();
+	Profile::Span span {"hydrant"};
+
+	// loops are rebound to the copy
+	LoopDepot copyDepot {depot, net};
+
+	Source* s {down_cast<Source>(net.getNode(r.node))};
+	const double base {s->getDischarge()};
+
+	r.solves = 0;
+	r.iterations = 0;
+	r.converged = true;
+
+	// flows of the last converged solve
+	vector<double> flows (net.getElementQty());
+	auto keep = [&]() {
+		for (int i {1}; i <= net.getElementQty(); i++)
+			flows[i-1] = net.getElement(i)->getFlow();
+	};
+
+	// warm started steady state with fire flow q,
+	//  flows of the last solve are the initial guess
+	auto draw = [&](const double& q) {
+		s->setDischarge(base - q);
+		Steady::balanceDischarge(net);
+
+		r.flow = q;
+		Steady::Status status {Steady::compute(net, copyDepot, trees, true,
+				1, NULL)};
+		r.iterations += status.iterations;
+		r.converged = status.converged;
+		r.solves++;
+
+		return margin(net, h, r);
+	};
+
+	// check the given flow
+	if (!h.isSearched()) {
+		double m {draw(h.flow)};
+
+		if (!r.converged)
+			r.status = "nonconv";
+		else if (!h.isConstrained())
+			r.status = "-";
+		else
+			r.status = m >= 0 ? "pass" : "fail";
+	}
+	// search the largest flow
+	else {
+		r.flow = 0;
+		double m_0 {margin(net, h, r)};
+		double s_0 {0};
+
+		// targets not met without fire flow
+		if (m_0 <= 0) {
+			r.status = "fail";
+		}
+		else {
+			const double tol {TOLERANCE * m_0};
+			double s_1 {pow(guess(net), 2)};
+			double m_1;
+			double next;
+
+			r.status = "limit";
+			keep();
+
+			while (r.solves < MAX_SOLVES) {
+				m_1 = draw(sqrt(s_1));
+
+				// no secant step from an unconverged solve,
+				//  restart halfway from the last converged
+				if (!r.converged) {
+					for (int i {1}; i <= net.getElementQty(); i++)
+						net.getElement(i)->setFlow(flows[i-1]);
+					s_1 = 0.5 * (s_0 + s_1);
+					continue;
+				}
+				keep();
+
+				if (abs(m_1) <= tol) {
+					r.status = "pass";
+					break;
+				}
+
+				// surplus must fall with the flow,
+				//  grow the flow until it does
+				if (m_1 >= m_0)
+					next = 10 * s_1;
+				else
+					next = s_1 - m_1 * (s_1 - s_0) / (m_1 - m_0);
+
+				// stay within the search range
+				if (next <= 0)
+					next = 0.25 * s_1;
+
+				s_0 = s_1;
+				m_0 = m_1;
+				s_1 = next;
+			}
+
+			// last solve is reported
+			if (!r.converged)
+				r.status = "nonconv";
+		}
+	}
+
+	r.seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+}
+
+void write(const Network& net, const vector<Result>& results)
+{
+	ofstream ofs {"fireflow.csv"};
+	if (!ofs)
+		throw runtime_error("FireFlow::write(): fireflow.csv");
+
+	ofs << "hydrant,flow,residual,min_pressure,min_node,solves,"
+		<< "iterations,converged,status\n"
+		<< setprecision(9)
+		<< fixed;
+
+	for (const Result& r : results) {
+		ofs << net.getNode(r.node)->getLabel() << ','
+			<< r.flow << ','
+			<< r.residual << ','
+			<< r.minPressure << ','
+			<< net.getNode(r.minNode)->getLabel() << ','
+			<< r.solves << ','
+			<< r.iterations << ','
+			<< r.converged << ','
+			<< r.status << '\n';
+	}
+}
+
+ostream& log(ostream& os, const Network& net, const vector<Result>& results)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << "\nListing fire flows:\n\n";
+	os << "|  Hydrant  |    Flow    |    Residual    |  Min pressure  |";
+	os << "   Node   |  Solves  |  Iterations  |  Converged  |  Wall time  |";
+	os << "  Status  |\n";
+	os << "|    [-]    |  [m3s-1]   |      [Pa]      |      [Pa]      |";
+	os << "   [-]    |   [-]    |     [-]      |     [-]     |     [s]     |";
+	os << "   [-]    |\n\n";
+
+	for (const Result& r : results) {
+		os << left
+		   << s_3
+		   << setw(8) << net.getNode(r.node)->getLabel()
+		   << s_2
+		   << scientific
+		   << setprecision(3)
+		   << setw(10) << r.flow
+		   << s_2
+		   << setw(14) << r.residual
+		   << s_2
+		   << setw(14) << r.minPressure
+		   << s_2
+		   << setw(8) << net.getNode(r.minNode)->getLabel()
+		   << s_2
+		   << setw(8) << r.solves
+		   << s_2
+		   << setw(12) << r.iterations
+		   << s_2
+		   << setw(11) << (r.converged ? "yes" : "no")
+		   << s_2
+		   << setw(11) << r.seconds
+		   << s_2
+		   << setw(8) << r.status
+		   << "|\n";
+	}
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+int find(const Network& net, const int& label)
+{
+	Node* n;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		n = net.getNode(i);
+
+		if (n->getLabel() != label)
+			continue;
+
+		if (!down_cast<Source>(n) || n->isFixed())
+			throw runtime_error("FireFlow::find(): hydrant "
+								+to_string(label)+" not a source");
+		return i;
+	}
+
+	throw runtime_error("FireFlow::find(): hydrant "
+						+to_string(label)+" missing");
+}
+
+double margin(const Network& net, const Hydrant& h, Result& r)
+{
+	r.residual = net.getNode(r.node)->getPressure();
+	r.minPressure = DBL_MAX;
+	r.minNode = 0;
+
+	// pressures at fixed heads are input
+	double p;
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (net.getNode(i)->isFixed())
+			continue;
+
+		p = net.getNode(i)->getPressure();
+
+		if (p < r.minPressure) {
+			r.minPressure = p;
+			r.minNode = i;
+		}
+	}
+
+	double m {DBL_MAX};
+	if (h.pressure >= 0)
+		m = min(m, r.residual - h.pressure);
+	if (h.minimum >= 0)
+		m = min(m, r.minPressure - h.minimum);
+
+	return m;
+}
+
+double guess(const Network& net)
+	// total demand of sources without fixed head
+{
+	double demand {0};
+	Source* s;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		s = down_cast<Source>(net.getNode(i));
+
+		if (s && !s->isFixed() && s->getDischarge() < 0)
+			demand -= s->getDischarge();
+	}
+
+	return demand > 0 ? demand : MIN_GUESS;
+}
+
+}
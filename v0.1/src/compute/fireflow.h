@@ -0,0 +1,101 @@
+// Declarations for fire flow computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: fireflow.cpp
+
+#ifndef FIREFLOW_H
+#define FIREFLOW_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<vector>
+
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Hydrant.h"
+#include"steadyState.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace FireFlow {
+
+// steady state with a fire flow drawn at a hydrant
+struct Result {
+	int node;
+		// id of hydrant node
+	double flow;						// [m3s-1]
+		// fire flow, given or found by the search
+	double residual;					// [Pa]
+		// pressure at hydrant node
+	double minPressure;					// [Pa]
+		// lowest pressure of nodes without fixed head
+	int minNode;
+		// id of node with lowest pressure
+	int solves;
+		// number of steady solves
+	int iterations;
+		// number of Hardy-Cross iterations of all solves
+	bool converged;
+		// check if Hardy-Cross iterations of the
+		//  reported solve met the tolerances
+	double seconds;						// [s]
+		// wall time of all solves
+	std::string status;
+		// pass, fail, limit if the search stopped
+		//  before meeting the target, nonconv if
+		//  the reported solve didn't converge,
+		//  - if unchecked
+};
+
+// Main function
+
+void compute(const Network&, const LoopDepot&);
+	// solve the steady state for each hydrant
+	//  in the 'hydrants' input file
+	// - network must hold a converged steady state
+	// - spanning trees are computed once and shared,
+	//   each hydrant is warm started from the base
+	//   flows and each search step from the last
+	// - hydrants run on worker threads
+
+// Tier 1 functions
+void solve(const Network&, const LoopDepot&, const Steady::Trees&,
+		const Hydrant&, Result&);
+	// solve a hydrant applied to a network copy
+	// - searched flows are found by secant steps
+	//   on the squared flow, pressure drops are
+	//   close to quadratic in the fire flow
+	// - unconverged solves take no part in the
+	//   search, the flow is halved back towards
+	//   the last converged one
+void write(const Network&, const std::vector<Result>&);
+	// write results to fireflow.csv
+	// - rows are labelled with input ids
+std::ostream& log(std::ostream&, const Network&,
+		const std::vector<Result>&);
+	// log output
+
+// Tier 2 functions
+int find(const Network&, const int&);
+	// id of hydrant node from input id
+	// - node must be a source without fixed head
+double margin(const Network&, const Hydrant&, Result&);
+	// smallest surplus of pressures over targets,
+	//  stores pressures to result
+double guess(const Network&);
+	// initial fire flow of a search
+
+}
+
+#endif
@@ -0,0 +1,429 @@
+// Definitions for rigid column computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<iostream>
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<chrono>
+
+#include"rigidColumn.h"
+#include"steadyState.h"
+#include"extendedPeriod.h"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Node.h"
+#include"Element.h"
+#include"Constant.h"
+#include"Utility.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Main function
+
+namespace Rigid {
+
+void compute(Network& net, const LoopDepot& depot)
+{
+	Profile::Span span {"rigidCompute"};
+	auto start = chrono::steady_clock::now();
+
+	// loops are rebound to the copy, closing
+	//  valves updates them
+	LoopDepot copyDepot {depot, net};
+	Model model;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (Valve* v = down_cast<Valve>(net.getNode(i))) {
+			model.valves.push_back(v);
+			model.loss.push_back(v->getLoss());
+			model.closed.push_back(0);
+		}
+	}
+	build(net, copyDepot, model);
+
+	// events advance by the rigid step
+	net.settings.timeStep = net.settings.rigidStep;
+
+	ofstream ofs {"rigid.csv"};
+	if (!ofs)
+		throw runtime_error("Rigid::compute(): rigid.csv");
+	writeHeader(ofs, net);
+
+	// symulate
+	int counter {0};
+
+	while (net.settings.time < net.settings.symTime) {
+		// check events
+		handleEvent(net, copyDepot, model);
+
+		// compute
+		step(net, copyDepot, model);
+
+		// write results
+		if (counter % net.settings.writeInterval == 0)
+			write(ofs, net);
+
+		// fill and drain reservoirs
+		Extended::integrate(net, net.settings.timeStep);
+
+		// increment
+		net.settings.time += net.settings.timeStep;
+		counter++;
+	}
+
+	// restore input losses
+	for (unsigned k {0}; k < model.valves.size(); k++) {
+		model.valves[k]->setLoss(model.loss[k]);
+	}
+
+	log(cout, model, counter, chrono::duration<double>(
+			chrono::steady_clock::now() - start).count());
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void build(const Network& net, const LoopDepot& depot, Model& model)
+{
+	Steady::Blocks blocks;
+	Steady::decompose(net, depot, blocks);
+
+	model.systems.assign(blocks.loops.size(), System {});
+
+	for (unsigned i {0}; i < blocks.loops.size(); i++) {
+		// assign
+		System& s {model.systems[i]};
+
+		s.loops = blocks.loops[i];
+		Steady::incidence(net, depot, s.loops, s.inc);
+		inertance(s.inc, s.M);
+	}
+
+	Steady::span(net, depot, model.trees);
+}
+
+void handleEvent(Network& net, LoopDepot& depot, Model& model)
+	// a valve closes the first of its two elements,
+	//  continuity stops the other
+{
+	bool changed {false};
+	Valve* v;
+	Element* e;
+
+	// flows before closures
+	vector<double> flow (net.getElementQty());
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		flow[i-1] = net.getElement(i)->getFlow();
+	}
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		net.getNode(i)->handleEvent(net.settings);
+	}
+
+	for (unsigned k {0}; k < model.valves.size(); k++) {
+		// assign
+		v = model.valves[k];
+
+		if (v->getState() == 0 && model.closed[k] == 0) {
+			if (v->links->getSize() != 2)
+				throw runtime_error("Rigid::handleEvent(): valve "
+									+to_string(v->getLabel())+" not two-way");
+
+			e = v->links->getElement(1);
+			e->setFlow(0);
+			depot.close(net, e->getId());
+			model.closed[k] = e->getId();
+			changed = true;
+		}
+		else if (v->getState() > 0 && model.closed[k] != 0) {
+			depot.open(net, model.closed[k]);
+			model.closed[k] = 0;
+			changed = true;
+		}
+
+		// loss of the current state, see
+		//  Valve::computeLoss()
+		if (v->getState() > 0) {
+			v->setLoss(model.loss[k]);
+			v->setLoss(v->computeLoss());
+		}
+	}
+
+	if (!changed)
+		return;
+
+	// flows of open elements satisfy continuity,
+	//  fixed heads take the change
+	build(net, depot, model);
+	Steady::correctInitial(net, model.trees);
+	project(net, model, flow);
+	Steady::computeDischarge(net);
+}
+
+void step(const Network& net, const LoopDepot& depot, Model& model)
+	// linearly implicit Euler step per block
+	/*
+	 * loop flows x follow M dx/dt = b, with b the
+	 * loop head loss residuals of the steady state;
+	 * one Newton step of backward Euler gives
+	 *
+	 *   (M / dt + A) x = b
+	 *
+	 * A - d(hf_i)/d(deltaQ_j) at current flows
+	 * b - hf_i at current flows
+	 * x - change of loop flows over the step
+	 *
+	 * continuity holds for any x, flows of
+	 * bridges are kept
+	 */
+{
+	Profile::Span span {"rigidStep"};
+
+	const Fluid& fluid {net.settings.fluid};
+	const double dt {net.settings.timeStep};
+
+	// flows before the step
+	vector<double> flow (net.getElementQty());
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		flow[i-1] = net.getElement(i)->getFlow();
+	}
+
+	// blocks are small, assembled serially
+	Steady::Pool pool {1};
+
+	for (System& s : model.systems) {
+		int size {int(s.loops.size())};
+
+		// fixed heads follow reservoir levels
+		for (int i {0}; i < size; i++) {
+			if (s.loops[i] > depot.getLNum()) {
+				LoopView l {depot.getView(s.loops[i])};
+				s.inc.head[i] = l.firstFree().getHead() - l.lastFree().getHead();
+			}
+		}
+
+		// M / dt + A is positive definite
+		Eigen::SparseMatrix<double> A (size, size);
+		Eigen::VectorXd b {size};
+		Eigen::VectorXd x {size};
+
+		Steady::assemble(fluid, s.inc, pool, A, b);
+		A += s.M / dt;
+
+		Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> factor {A};
+		if (factor.info() == Eigen::Success)
+			x = factor.solve(b);
+
+		if (factor.info() != Eigen::Success || !x.allFinite())
+			throw runtime_error("Rigid::step(): diverged");
+
+		Steady::update(s.inc, x);
+	}
+
+	Steady::computeDischarge(net);
+	Steady::computeHead(net, model.trees);
+	computeInertia(net, model.trees, flow, dt);
+	Steady::computePressure(net);
+}
+
+void write(ofstream& ofs, const Network& net)
+{
+	ofs << setprecision(9)
+		<< scientific
+		<< net.settings.time;
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		ofs << ',' << net.getElement(i)->getFlow();
+	}
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		ofs << ',' << net.getNode(i)->getHead();
+	}
+	ofs << '\n';
+}
+
+ostream& log(ostream& os, const Model& model, const int& steps,
+		const double& seconds)
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+	int loops {0};
+
+	for (const System& s : model.systems) {
+		loops += s.loops.size();
+	}
+
+	os << "\nListing rigid column:\n\n";
+	os << "|  Steps  |  Blocks  |  Loops  |  Wall time  |\n";
+	os << "|   [-]   |   [-]    |   [-]   |     [s]     |\n\n";
+	os << left
+	   << s_3
+	   << setw(6) << steps
+	   << s_3
+	   << setw(7) << model.systems.size()
+	   << s_3
+	   << setw(6) << loops
+	   << s_2
+	   << scientific
+	   << setprecision(3)
+	   << setw(11) << seconds
+	   << "|\n";
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+void inertance(const Steady::Incidence& inc, Eigen::SparseMatrix<double>& M)
+	/*
+	 * element k of length L and area A adds
+	 *
+	 *   o_i o_j L / (g A) to M_ij
+	 *
+	 * for all loops i, j containing it, the
+	 * pattern of the Hardy-Cross matrix
+	 */
+{
+	vector<Eigen::Triplet<double>> triplets;
+	Element* e;
+	double m;
+
+	for (unsigned k {0}; k < inc.element.size(); k++) {
+		// assign
+		e = inc.element[k];
+		m = e->getLength() / (GRAVITY * e->computeArea());
+
+		// lower triangle, loops of an element
+		//  are in ascending order
+		for (int p {inc.offset[k]}; p < inc.offset[k+1]; p++) {
+			for (int s {inc.offset[k]}; s <= p; s++) {
+				triplets.push_back(Eigen::Triplet<double> {inc.loop[p],
+						inc.loop[s], inc.orientation[p]*inc.orientation[s] * m});
+			}
+		}
+	}
+
+	M.resize(inc.head.size(), inc.head.size());
+	M.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+void project(const Network& net, Model& model, const vector<double>& flow)
+	// impulsive change of flows at a closure
+	/*
+	 * loop flows x keep as much momentum of the
+	 * elements as continuity allows, minimizing
+	 *
+	 *   sum L / (g A) (q + dq - q_0)^2
+	 *
+	 * dq - change of flow by its loops
+	 * q_0 - flow before the closure
+	 *
+	 * so that M x = sum o_i L / (g A) (q_0 - q)
+	 */
+{
+	Element* e;
+	double d;
+
+	for (System& s : model.systems) {
+		Eigen::VectorXd r {Eigen::VectorXd::Zero(s.loops.size())};
+
+		for (unsigned k {0}; k < s.inc.element.size(); k++) {
+			// assign
+			e = s.inc.element[k];
+			d = e->getLength() / (GRAVITY * e->computeArea())
+				* (flow[e->getId()-1] - e->getFlow());
+
+			for (int p {s.inc.offset[k]}; p < s.inc.offset[k+1]; p++)
+				r(s.inc.loop[p]) += s.inc.orientation[p] * d;
+		}
+
+		Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> factor {s.M};
+		Eigen::VectorXd x {r.rows()};
+		if (factor.info() == Eigen::Success)
+			x = factor.solve(r);
+
+		if (factor.info() != Eigen::Success || !x.allFinite())
+			throw runtime_error("Rigid::project(): singular");
+
+		Steady::update(s.inc, x);
+	}
+}
+
+void computeInertia(const Network& net, const Steady::Trees& trees,
+		const vector<double>& flow, const double& dt)
+	// accumulate inertial heads from fixed head nodes
+	/*
+	 * H_start - H_end = L / (g A) dq/dt
+	 *
+	 * on top of friction, see Steady::computeHead
+	 */
+{
+	const Steady::Forest& f {trees.head};
+	double inertia {0};
+		// inertial head
+	Element* e;
+	Node* n;
+	int id {0};
+
+	vector<double> y (net.getNodeQty(), 0);
+
+	for (int i : f.order) {
+		// roots are fixed
+		if (f.parent[i-1] == 0)
+			continue;
+
+		// assign
+		e = net.getElement(f.parent[i-1]);
+		inertia = e->getLength() / (GRAVITY * e->computeArea())
+				  * (e->getFlow() - flow[e->getId()-1]) / dt;
+		id = f.from[i-1];
+
+		// going down or up the element
+		if (e->getEnd().getId() == i)
+			y[i-1] = y[id-1] - inertia;
+		else
+			y[i-1] = y[id-1] + inertia;
+	}
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		// assign
+		n = net.getNode(i+1);
+
+		if (!n->isFixed())
+			n->setHead(n->getHead() + y[i]);
+	}
+}
+
+void writeHeader(ofstream& ofs, const Network& net)
+{
+	ofs << "time";
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		ofs << ",flow_" << net.getElement(i)->getLabel();
+	}
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		ofs << ",head_" << net.getNode(i)->getLabel();
+	}
+	ofs << '\n';
+}
+
+}
@@ -0,0 +1,102 @@
+// Declarations for rigid column computation functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: rigidColumn.cpp
+
+#ifndef RIGID_COLUMN_H
+#define RIGID_COLUMN_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<fstream>
+#include<vector>
+
+#include"Sparse"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"steadyState.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Rigid {
+
+// loops of a biconnected block with their inertance
+struct System {
+	std::vector<int> loops;
+		// ids of loops and pseudoloops in depot
+	Steady::Incidence inc;
+		// loops of elements of the block
+	Eigen::SparseMatrix<double> M;		// [s2m-2]
+		// lower triangle of the inertance of loops,
+		//  o_i o_j L / (g A) summed over elements
+};
+
+// loops and trees of the open elements
+struct Model {
+	std::vector<System> systems;
+		// blocks of loops, bridges carry the flows
+		//  of continuity and are not integrated
+	Steady::Trees trees;
+		// spanned over open elements
+	std::vector<Valve*> valves;
+		// valves of the network
+	std::vector<double> loss;
+		// input loss of valves
+	std::vector<int> closed;
+		// element closed by valve, 0 if open
+};
+
+// Main function
+
+void compute(Network&, const LoopDepot&);
+	// integrate flows of an incompressible network
+	//  from the steady state to the symulation time
+	//  in steps of settings.rigidStep
+	// - network must hold a converged steady state
+	// - valve events change valve losses, a closed
+	//   valve closes one of its elements and flows
+	//   jump keeping as much momentum as they can
+	// - levels of reservoirs with a surface area
+	//   follow their discharges
+	// - valve losses are restored on return
+
+// Tier 1 functions
+void build(const Network&, const LoopDepot&, Model&);
+	// form systems of blocks and span trees
+void handleEvent(Network&, LoopDepot&, Model&);
+	// advance valve states by one step, close
+	//  and reopen valves, rebuild if changed
+void step(const Network&, const LoopDepot&, Model&);
+	// advance flows by one step
+void write(std::ofstream&, const Network&);
+	// write time step to rigid.csv
+std::ostream& log(std::ostream&, const Model&, const int&, const double&);
+	// log output
+
+// Tier 2 functions
+void inertance(const Steady::Incidence&, Eigen::SparseMatrix<double>&);
+	// assemble lower triangle of the inertance
+	//  of loops
+void project(const Network&, Model&, const std::vector<double>&);
+	// change flows of open elements by the
+	//  least momentum from the given flows
+void computeInertia(const Network&, const Steady::Trees&,
+		const std::vector<double>&, const double&);
+	// add inertial heads, L / (g A) dq/dt, to the
+	//  heads at nodes
+void writeHeader(std::ofstream&, const Network&);
+	// write header of rigid.csv
+
+}
+
+#endif
@@ -0,0 +1,395 @@
+// Definitions for steady state sensitivity functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<algorithm>
+#include<cmath>
+
+#include"sensitivity.h"
+#include"Dense"
+#include"Network.h"
+#include"Element.h"
+#include"Node.h"
+#include"Loop.h"
+#include"Fluid.h"
+#include"Constant.h"
+#include"Utility.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Constants
+
+static const double FLOW_FLOOR {1e-3};
+	// smallest flow in linearization relative to largest,
+	//  keeps conductances of stagnant elements finite
+static const double DELTA {1e-6};
+	// relative step of central differences
+	//  of element head losses
+
+//=============================================================================
+//
+//	Main function
+
+namespace Sensitivity {
+
+string parameterName(const int& parameter)
+{
+	switch (parameter) {
+		case ROUGHNESS:
+			return "roughness";
+		case DIAMETER:
+			return "diameter";
+		case DISCHARGE:
+			return "discharge";
+		default:
+			throw runtime_error("Sensitivity::parameterName(): parameter");
+	}
+}
+
+void compute(const Network& net, const vector<int>& nodes, Sensitivities& s)
+{
+	Profile::Span span {"sensitivity"};
+
+	System system;
+	linearize(net, system);
+
+	// one adjoint solve per monitored node
+	Eigen::MatrixXd lambda {adjoint(net, system, nodes)};
+
+	s.nodes = nodes;
+	s.roughness = derive(net, system, lambda, nodes, ROUGHNESS);
+	s.diameter = derive(net, system, lambda, nodes, DIAMETER);
+	s.discharge = derive(net, system, lambda, nodes, DISCHARGE);
+}
+
+//=============================================================================
+//
+//	Tier 1 functions
+
+void linearize(const Network& net, System& system)
+	/*
+	 * continuity at free nodes, F(H) = A * q(H) - d = 0
+	 *  with h = H_start - H_end through each element
+	 *
+	 * dF/dH = sum of g * a * a^T over elements,
+	 *  g = dq/dh = 1 / (dh/dq), a = start - end
+	 *  restricted to free nodes
+	 *
+	 * dh/dq includes the change of the friction
+	 *  factor with flow, unlike 2 * r * |q|
+	 */
+{
+	// rows of free nodes
+	int rows {0};
+	system.row.assign(net.getNodeQty(), -1);
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (!net.getNode(i+1)->isFixed())
+			system.row[i] = rows++;
+	}
+
+	// floor of linearized flows
+	double floor {0};
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		floor = max(floor, abs(net.getElement(i)->getFlow()));
+	}
+	floor = floor > 0 ? FLOW_FLOOR * floor : FLOW_FLOOR;
+
+	Eigen::MatrixXd L {Eigen::MatrixXd::Zero(rows, rows)};
+	system.conductance.resize(net.getElementQty());
+	Element* e;
+	double g;
+	int s;
+	int t;
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		// assign
+		e = net.getElement(i);
+		g = 1 / slope(e, net.settings.fluid, floor);
+
+		s = system.row[e->getStart().getId()-1];
+		t = system.row[e->getEnd().getId()-1];
+
+		system.conductance[i-1] = g;
+
+		// stamp
+		if (s >= 0)
+			L(s, s) += g;
+		if (t >= 0)
+			L(t, t) += g;
+		if (s >= 0 && t >= 0) {
+			L(s, t) -= g;
+			L(t, s) -= g;
+		}
+	}
+
+	system.factor.compute(L);
+	if (system.factor.info() != Eigen::Success)
+		throw runtime_error("Sensitivity::linearize(): singular");
+}
+
+Eigen::MatrixXd adjoint(const Network& net, const System& system,
+		const vector<int>& nodes)
+	/*
+	 * heads at nodes are total heads x less the mean
+	 *  dynamic head of linked elements, to first order
+	 *
+	 * dH_k = dx_k - sum of w_ke * dq_e over linked elements
+	 *
+	 * dF/dH is symmetric, so the adjoint of monitored
+	 *  node k solves dF/dH * lambda_k = c_k with
+	 *
+	 * c_k = e_k - sum of w_ke * g_e * a_e
+	 */
+{
+	int size {int(nodes.size())};
+	Eigen::MatrixXd B {Eigen::MatrixXd::Zero(system.factor.rows(), size)};
+	Loop* l;
+	Element* e;
+	double c;
+	int s;
+	int t;
+
+	for (int k {0}; k < size; k++) {
+		// fixed heads do not change
+		if (system.row[nodes[k]-1] < 0)
+			continue;
+
+		B(system.row[nodes[k]-1], k) = 1;
+
+		l = net.getNode(nodes[k])->links;
+		for (int j {1}; j <= l->getSize(); j++) {
+			// assign
+			e = l->getElement(j);
+			c = weight(net, nodes[k], e) * system.conductance[e->getId()-1];
+
+			s = system.row[e->getStart().getId()-1];
+			t = system.row[e->getEnd().getId()-1];
+
+			if (s >= 0)
+				B(s, k) -= c;
+			if (t >= 0)
+				B(t, k) += c;
+		}
+	}
+
+	Eigen::MatrixXd X {system.factor.solve(B)};
+	Eigen::MatrixXd lambda {Eigen::MatrixXd::Zero(net.getNodeQty(), size)};
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (system.row[i] >= 0)
+			lambda.row(i) = X.row(system.row[i]);
+	}
+
+	return lambda;
+}
+
+Eigen::MatrixXd derive(const Network& net, const System& system,
+		const Eigen::MatrixXd& lambda, const vector<int>& nodes,
+		const int& parameter)
+	/*
+	 * discharge d_j enters continuity directly:
+	 *  dH_k/dd_j = lambda_k(j)
+	 *
+	 * element parameter p changes the flow at fixed
+	 *  heads by -g * dh/dp:
+	 *  dH_k/dp = g * dh/dp * (lambda_k(start) - lambda_k(end))
+	 *
+	 * elements linked to node k also change its dynamic
+	 *  head directly, through the flow and for the
+	 *  diameter through the area
+	 */
+{
+	// nodal parameter
+	if (parameter == DISCHARGE)
+		return lambda.transpose();
+
+	Eigen::MatrixXd D {Eigen::MatrixXd::Zero(lambda.cols(),
+											 net.getElementQty())};
+	vector<double> c (net.getElementQty());
+	Element* e;
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		// assign
+		e = net.getElement(i);
+		c[i-1] = system.conductance[i-1] * partial(e, net.settings.fluid, parameter);
+
+		D.col(i-1) = c[i-1] * (lambda.row(e->getStart().getId()-1)
+							   - lambda.row(e->getEnd().getId()-1)).transpose();
+	}
+
+	// direct change of dynamic heads
+	Loop* l;
+	double w;
+
+	for (unsigned k {0}; k < nodes.size(); k++) {
+		if (net.getNode(nodes[k])->isFixed())
+			continue;
+
+		l = net.getNode(nodes[k])->links;
+		for (int j {1}; j <= l->getSize(); j++) {
+			// assign
+			e = l->getElement(j);
+			w = weight(net, nodes[k], e);
+
+			D(k, e->getId()-1) += w * c[e->getId()-1];
+
+			// dA/dD = 2 * A / D
+			if (parameter == DIAMETER)
+				D(k, e->getId()-1) += w * e->getFlow() * 2 / e->getDiameter();
+		}
+	}
+
+	return D;
+}
+
+void write(const Network& net, const Sensitivities& s)
+{
+	ofstream ofs {"sensitivity.csv"};
+	if (!ofs)
+		throw runtime_error("Sensitivity::write(): sensitivity.csv");
+
+	ofs << "parameter,id";
+	for (int n : s.nodes) {
+		ofs << ",dH_" << net.getNode(n)->getLabel();
+	}
+	ofs << '\n'
+		<< setprecision(9)
+		<< scientific;
+
+	const Eigen::MatrixXd* D;
+
+	for (int p : {ROUGHNESS, DIAMETER}) {
+		D = p == ROUGHNESS ? &s.roughness : &s.diameter;
+
+		for (int i {0}; i < net.getElementQty(); i++) {
+			ofs << parameterName(p) << ','
+				<< net.getElement(i+1)->getLabel();
+			for (int k {0}; k < D->rows(); k++) {
+				ofs << ',' << (*D)(k, i);
+			}
+			ofs << '\n';
+		}
+	}
+
+	// discharges at fixed heads are results
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (net.getNode(i+1)->isFixed())
+			continue;
+
+		ofs << parameterName(DISCHARGE) << ','
+			<< net.getNode(i+1)->getLabel();
+		for (int k {0}; k < s.discharge.rows(); k++) {
+			ofs << ',' << s.discharge(k, i);
+		}
+		ofs << '\n';
+	}
+}
+
+//=============================================================================
+//
+//	Tier 2 functions
+
+double headLoss(Element* e, const Fluid& fluid)
+{
+	double q {e->getFlow()};
+
+	return e->computeHeadLossC(fluid) * q * abs(q);
+}
+
+double slope(Element* e, const Fluid& fluid, const double& floor)
+{
+	double q {e->getFlow()};
+	double x {q};
+
+	// stagnant elements have no friction,
+	//  differentiate at the floor instead
+	if (abs(x) < floor)
+		x = q < 0 ? -floor : floor;
+
+	double dx {DELTA * abs(x)};
+	double h_1;
+	double h_0;
+
+	e->setFlow(x + dx);
+	h_1 = headLoss(e, fluid);
+	e->setFlow(x - dx);
+	h_0 = headLoss(e, fluid);
+	e->setFlow(q);
+
+	return (h_1 - h_0) / (2 * dx);
+}
+
+double weight(const Network& net, const int& id, Element* e)
+	/*
+	 * v = sum of |q_e| / A_e / n over n linked elements
+	 *
+	 * d(v^2 / 2g)/dq_e = v / g * sgn(q_e) / (A_e * n)
+	 */
+{
+	Loop* l {net.getNode(id)->links};
+	double v {0};
+
+	for (int j {1}; j <= l->getSize(); j++) {
+		v += abs(l->getElement(j)->computeVelocity());
+	}
+	v /= l->getSize();
+
+	return v / GRAVITY * signum(e->getFlow())
+		   / (e->computeArea() * l->getSize());
+}
+
+double partial(Element* e, const Fluid& fluid, const int& parameter)
+	// zero for smooth elements by roughness
+{
+	double x;
+
+	if (parameter == ROUGHNESS)
+		x = e->getRoughness();
+	else if (parameter == DIAMETER)
+		x = e->getDiameter();
+	else
+		throw runtime_error("Sensitivity::partial(): parameter");
+
+	if (x <= 0)
+		return 0;
+
+	double dx {DELTA * x};
+	double h_1;
+	double h_0;
+
+	auto set = [&](const double& value) {
+		if (parameter == ROUGHNESS)
+			e->setRoughness(value);
+		else
+			e->setDiameter(value);
+	};
+
+	set(x + dx);
+	h_1 = headLoss(e, fluid);
+	set(x - dx);
+	h_0 = headLoss(e, fluid);
+	set(x);
+
+	return (h_1 - h_0) / (2 * dx);
+}
+
+}
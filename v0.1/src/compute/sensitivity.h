@@ -0,0 +1,108 @@
+// Declarations for steady state sensitivity functions
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+//
+// definitions in: sensitivity.cpp
+
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<string>
+#include<vector>
+
+#include"Dense"
+#include"Network.h"
+#include"Element.h"
+#include"Fluid.h"
+
+//=============================================================================
+//
+//	Declarations
+
+namespace Sensitivity {
+
+enum Parameter {ROUGHNESS = 0, DIAMETER, DISCHARGE};
+
+std::string parameterName(const int&);
+	// name of parameter
+
+// nodal continuity of the steady state
+//  linearized in heads
+struct System {
+	std::vector<int> row;
+		// row of node by id-1, -1 for fixed heads
+	std::vector<double> conductance;	// [m2s-1]
+		// dq/dh of elements by id-1
+	Eigen::LLT<Eigen::MatrixXd> factor;
+		// Cholesky factor of the conductance
+		//  weighted Laplacian of free nodes
+};
+
+// derivatives of heads at monitored nodes
+struct Sensitivities {
+	std::vector<int> nodes;
+		// ids of monitored nodes
+	Eigen::MatrixXd roughness;			// [-]
+		// by monitored node and element id-1
+	Eigen::MatrixXd diameter;			// [-]
+		// by monitored node and element id-1
+	Eigen::MatrixXd discharge;			// [sm-2]
+		// by monitored node and node id-1,
+		//  zero for fixed heads
+};
+
+// Main function
+
+void compute(const Network&, const std::vector<int>&, Sensitivities&);
+	// derivatives of heads at monitored nodes with
+	//  respect to roughness and diameter of all
+	//  elements and discharges of all nodes
+	// - input are ids of monitored nodes
+	// - network must hold a converged steady state
+	// - one adjoint solve per monitored node with a
+	//   single factorization, independent of the
+	//   number of parameters
+
+// Tier 1 functions
+void linearize(const Network&, System&);
+	// assemble and factorize the Jacobian of
+	//  nodal continuity in heads
+Eigen::MatrixXd adjoint(const Network&, const System&,
+		const std::vector<int>&);
+	// adjoint heads by node id-1 and monitored node
+	// - heads at nodes exclude the dynamic head,
+	//   see Steady::computeHead
+Eigen::MatrixXd derive(const Network&, const System&,
+		const Eigen::MatrixXd&, const std::vector<int>&, const int&);
+	// derivatives of heads at monitored nodes
+	//  with respect to a parameter of all
+	//  elements or nodes, from adjoint heads
+void write(const Network&, const Sensitivities&);
+	// write derivatives to sensitivity.csv
+	// - rows are labelled with input ids
+
+// Tier 2 functions
+double headLoss(Element*, const Fluid&);
+	// head loss through element at its flow
+double slope(Element*, const Fluid&, const double&);
+	// derivative of head loss with respect to flow,
+	//  flows below the floor are raised to it
+double weight(const Network&, const int&, Element*);
+	// derivative of dynamic head at node with
+	//  respect to flow through linked element
+	// - input is id of node
+double partial(Element*, const Fluid&, const int&);
+	// derivative of head loss with respect to
+	//  roughness or diameter at fixed flow
+
+}
+
+#endif
@@ -6,16 +6,29 @@
 // tested:	16-9-2018
 // status:	working
 //
-// last edit:	16-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
 //	Headers
 
+#include<ostream>
+#include<iomanip>
 #include<cmath>
+#include<stdexcept>
+#include<exception>
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<utility>
+#include<algorithm>
+#include<functional>
 
 #include"steadyState.h"
 #include"Dense"
+#include"Sparse"
 #include"Node.h"
 #include"Element.h"
 #include"Loop.h"
@@ -23,35 +36,103 @@
 #include"Network.h"
 #include"LoopDepot.h"
 #include"Utility.h"
+#include"Profile.h"
 using namespace std;
 
+//=============================================================================
+//
+//	Constants
+
+static const int PARALLEL_LOOPS {32};
+	// smallest number of loops of the second largest
+	//  block for blocks to be solved in parallel
+static const int PARALLEL_ELEMENTS {2048};
+	// smallest number of elements of a block
+	//  assembled on several threads
+static const int SPARSE_LOOPS {256};
+	// smallest number of loops of a block
+	//  factored as a sparse matrix
+static const double ARMIJO {1e-4};
+	// least relative decrease of the squared
+	//  residual per unit step
+static const int MAX_HALVINGS {10};
+	// largest number of step halvings
+static const double PROGRESS {0.9};
+	// least relative decrease of the largest
+	//  residual counted as progress
+static const int MAX_STALLS {10};
+	// iterations without progress before
+	//  a block is given up
+
 //=============================================================================
 //
 //	Main function
 
 namespace Steady {
 
-void compute(const Network& net, const LoopDepot& depot)
+Status compute(const Network& net, const LoopDepot& depot,
+		const int& threads, ostream* log)
 	// compute steady state for a hydraulic network
 {
+	Profile::Timer timer {Profile::STEADY};
+
 	// assume missing discharges
 	//  if necesary
 	assumeDischarge(net);
 
+	// span trees of the network
+	Trees trees;
+	span(net, trees);
+
 	// compute initial assumption of flows through elements
-	computeInitial(net);
+	computeInitial(net, trees);
 
 	// hardy cross
-	hardyCross(net, depot);
+	Status status {hardyCross(net, depot, threads, log)};
 
 	// recompute assumed discharges
 	computeDischarge(net);
 
 	// compute heads at nodes
-	computeHead(net);
+	computeHead(net, trees);
 
 	// compute pressures at nodes
 	computePressure(net);
+
+	return status;
+}
+
+Status compute(const Network& net, const LoopDepot& depot,
+		const Trees& trees, const bool& warm, const int& threads,
+		ostream* log)
+	// compute steady state for a hydraulic network
+	//  with trees spanned beforehand
+{
+	Profile::Timer timer {Profile::STEADY};
+
+	// assume missing discharges
+	//  if necesary
+	assumeDischarge(net);
+
+	// correct or compute initial assumption of flows
+	if (warm)
+		correctInitial(net, trees);
+	else
+		computeInitial(net, trees);
+
+	// hardy cross
+	Status status {hardyCross(net, depot, threads, log)};
+
+	// recompute assumed discharges
+	computeDischarge(net);
+
+	// compute heads at nodes
+	computeHead(net, trees);
+
+	// compute pressures at nodes
+	computePressure(net);
+
+	return status;
 }
 
 //=============================================================================
@@ -61,6 +142,9 @@ void compute(const Network& net, const LoopDepot& depot)
 void assumeDischarge(const Network& net)
 	// check if all discharges are set
 	// redistribure surplus to unset reservoirs
+	// - only fixed heads can be unset, a source
+	//   without one keeps its discharge, which
+	//   modes may set to zero
 {
 	// compute current sum of discharges
 	double dischargeSum {0};
@@ -69,7 +153,7 @@ void assumeDischarge(const Network& net)
 	// scan for reservoirs
 	for (int i {1}; i <= net.getNodeQty(); i++) {
 		if (Source* r = recastToSource(net.getNode(i))) {
-			if (r->getDischarge() == 0)
+			if (r->getDischarge() == 0 && r->isFixed())
 				unset++;
 			else
 				dischargeSum += r->getDischarge();
@@ -85,99 +169,421 @@ void assumeDischarge(const Network& net)
 
 	for (int i {1}; i <= net.getNodeQty(); i++) {
 		if (Source* r = recastToSource(net.getNode(i))) {
-			if (r->getDischarge() == 0)
+			if (r->getDischarge() == 0 && r->isFixed())
 				r->setDischarge(guess);
 		}
 	}
 }
 
-void computeInitial(const Network& net)
-	// solve Ax = b
+void span(const Network& net, Trees& trees)
+	// span forests depending only on topology
 	/*
-	 * A - coefficient matrix of elements
-	 * b - nodal discharges
-	 * x - flows through elements
+	 * continuity - one root per connected part,
+	 *              flows of remaining elements
+	 *              (chords) are free
+	 * head       - rooted at fixed head nodes
+	 */
+{
+	vector<int> roots;
+
+	// any node roots a connected part
+	span(net, roots, trees.continuity);
+
+	// fixed heads root the head forest
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (net.getNode(i)->isFixed())
+			roots.push_back(i);
+	}
+	span(net, roots, trees.head);
+
+	// every node needs a fixed head
+	if (int(trees.head.order.size()) != net.getNodeQty())
+		throw runtime_error("Steady::span(): part without fixed head");
+}
+
+void span(const Network& net, const LoopDepot& depot, Trees& trees)
+	// closed elements carry no flow and join no heads,
+	//  fixed heads also root the continuity forest:
+	//  closing changes their discharges, which stay
+	//  at the roots and are recomputed
+{
+	vector<int> roots;
+	vector<bool> closed (net.getElementQty());
+
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		closed[i-1] = depot.isClosed(i);
+	}
+
+	for (int k {0}; k < 2; k++) {
+		for (int i {1}; i <= net.getNodeQty(); i++) {
+			if (net.getNode(i)->isFixed())
+				roots.push_back(i);
+		}
+		span(net, roots, k == 0 ? trees.continuity : trees.head, closed);
+	}
+
+	// every node needs a fixed head
+	if (int(trees.head.order.size()) != net.getNodeQty())
+		throw runtime_error("Steady::span(): part without fixed head");
+}
+
+void balanceDischarge(const Network& net)
+	// discharges at fixed head nodes are results
+	//  of the computation, balancing them gives
+	//  a consistent continuity system after
+	//  other discharges changed
+{
+	double sum {0};
+		// sum of nodal discharges
+	int count {0};
+		// number of fixed head sources
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (Source* s = recastToSource(net.getNode(i))) {
+			sum += s->getDischarge();
+			if (s->isFixed())
+				count++;
+		}
+	}
+
+	if (count == 0)
+		return;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (Source* s = recastToSource(net.getNode(i))) {
+			if (s->isFixed())
+				s->setDischarge(s->getDischarge() - sum / count);
+		}
+	}
+}
+
+void computeInitial(const Network& net, const Trees& trees)
+	// flows through chords are zero,
+	//  tree flows follow from continuity
+{
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		net.getElement(i)->setFlow(0);
+	}
+
+	correctInitial(net, trees);
+}
+
+void correctInitial(const Network& net, const Trees& trees)
+	// remove residual of continuity
+	/*
+	 * chords keep their flows, tree elements take
+	 * the residual of the node below them; nodes
+	 * are processed from leaves to roots so each
+	 * residual is final when it is taken
 	 *
-	 * solve using Householder rank-revealing
-	 * QR decomposition of a matrix
-	 * with column pivoting.
+	 * residual at roots is zero for
+	 * balanced nodal discharges
 	 */
 {
-	// initialize matrices
-	Eigen::MatrixXd A {net.getNodeQty(), net.getElementQty()};
-	Eigen::VectorXd b {net.getNodeQty()};
+	const Forest& f {trees.continuity};
+	vector<double> r {residual(net)};
+	Element* e;
+	int n {0};
+
+	for (int i {int(f.order.size())-1}; i >= 0; i--) {
+		// assign
+		n = f.order[i];
+
+		// skip roots
+		if (f.parent[n-1] == 0)
+			continue;
+
+		// correct tree element
+		e = net.getElement(f.parent[n-1]);
+		e->setFlow(e->getFlow() + f.sign[n-1]*r[n-1]);
+
+		// pass residual to parent
+		r[f.from[n-1]-1] += r[n-1];
+	}
+}
+
+void decompose(const Network& net, const LoopDepot& depot, Blocks& blocks)
+	// Tarjan's search for biconnected components,
+	//  iterative to allow long branches
+{
+	int n {net.getNodeQty()};
+	int m {net.getElementQty()};
+	Element* e;
+
+	// ends of edges by id, node 0 is virtual and
+	//  joined to fixed heads by edges numbered
+	//  above elements
+	vector<pair<int, int>> ends (m+1, {0, 0});
+	ends.reserve(m+n+1);
+	int edges {m};
 
-	// fill with zeros
-	for (int i {0}; i < A.rows(); i++) {
-		for (int j {0}; j < A.cols(); j++) {
-			A(i, j) = 0;
+	for (int j {1}; j <= m; j++) {
+		if (depot.isClosed(j))
+			continue;
+
+		e = net.getElement(j);
+		ends[j] = {e->getStart().getId(), e->getEnd().getId()};
+	}
+	for (int i {1}; i <= n; i++) {
+		if (net.getNode(i)->isFixed()) {
+			ends.push_back({0, i});
+			edges++;
 		}
 	}
 
-	// fill matrices
-	int col {0};		// A column, element id
-	Node* n;
+	// adjacent edges by node id in flat storage,
+	//  from offset[i] to offset[i+1]
+	vector<int> offset (n+2, 0);
+	vector<int> adjacent (2*edges);
 
-	for (int i {0}; i < net.getNodeQty(); i++) {
+	for (int j {1}; j <= edges; j++) {
+		if (ends[j].first == ends[j].second)
+			continue;
+		offset[ends[j].first+1]++;
+		offset[ends[j].second+1]++;
+	}
+	for (int i {0}; i <= n; i++)
+		offset[i+1] += offset[i];
+
+	vector<int> position (offset.begin(), offset.end()-1);
+	for (int j {1}; j <= edges; j++) {
+		if (ends[j].first == ends[j].second)
+			continue;
+		adjacent[position[ends[j].first]++] = j;
+		adjacent[position[ends[j].second]++] = j;
+	}
+
+	blocks.element.assign(m, 0);
+	blocks.loops.clear();
+	blocks.bridges = 0;
+
+	vector<int> discovery (n+1, -1);
+	vector<int> low (n+1, 0);
+	vector<int> parent (n+1, 0);
+		// edge to parent node
+	vector<pair<int, int>> path;
+		// node and position of next adjacent edge
+	vector<int> stack;
+		// edges of unfinished blocks
+	int time {0};
+	int size {0};
+	int v;
+	int w;
+
+	for (int root {0}; root <= n; root++) {
+		if (discovery[root] >= 0)
+			continue;
+
+		discovery[root] = low[root] = time++;
+		path.push_back({root, offset[root]});
+
+		while (!path.empty()) {
+			v = path.back().first;
+
+			// descend or note back edge
+			if (path.back().second < offset[v+1]) {
+				int j {adjacent[path.back().second++]};
+				w = ends[j].first == v ? ends[j].second : ends[j].first;
+
+				if (j == parent[v])
+					continue;
+
+				if (discovery[w] < 0) {
+					discovery[w] = low[w] = time++;
+					parent[w] = j;
+					stack.push_back(j);
+					path.push_back({w, offset[w]});
+				}
+				else if (discovery[w] < discovery[v]) {
+					low[v] = min(low[v], discovery[w]);
+					stack.push_back(j);
+				}
+				continue;
+			}
+
+			// ascend, v is done
+			path.pop_back();
+			if (path.empty())
+				break;
+
+			w = path.back().first;
+			low[w] = min(low[w], low[v]);
+
+			if (low[v] < discovery[w])
+				continue;
+
+			// w separates a block, a single element
+			//  is a bridge
+			if (stack.back() == parent[v] && parent[v] <= m) {
+				blocks.bridges++;
+				stack.pop_back();
+				continue;
+			}
+
+			size++;
+			int j;
+			do {
+				j = stack.back();
+				stack.pop_back();
+				if (j <= m)
+					blocks.element[j-1] = size;
+			} while (j != parent[v]);
+		}
+	}
+
+	// blocks joined by a loop are merged, a depot
+	//  loop need not be a cycle of a single block
+	vector<int> root (size+2);
+	for (unsigned i {0}; i < root.size(); i++)
+		root[i] = i;
+
+	auto find = [&](int b) {
+		while (root[b] != b)
+			b = root[b] = root[root[b]];
+		return b;
+	};
+
+	int noLoops {depot.getLNum()+depot.getPNum()};
+	vector<int> block (noLoops, 0);
+	int b;
+
+	for (int i {1}; i <= noLoops; i++) {
 		// assign
-		n = net.getNode(i+1);
+		LoopView l {depot.getView(i)};
+		b = 0;
 
-		// fill discharge matrix
-		if (Source* r = recastToSource(n))
-			b(i) = r->getDischarge();
-		else
-			b(i) = 0;
+		for (int j {1}; j <= l.getSize(); j++) {
+			int c {blocks.element[l.getElement(j)->getId()-1]};
 
-		// fill coefficient matrix
-		for (int j {0}; j < n->links->getSize(); j++) {
-			// get column
-			col = n->links->getElement(j+1)->getId()-1;
-			// set coefficient
-			A(i, col) = n->links->getOrientation(j+1);
+			if (c == 0)
+				continue;
+			if (b == 0)
+				b = find(c);
+			else
+				root[find(c)] = b;
 		}
+
+		// loops of no block share a last one
+		block[i-1] = b == 0 ? size+1 : b;
 	}
-	// solve
-	Eigen::VectorXd x {A.colPivHouseholderQr().solve(b)};
 
-	// store flows to elements
-	for (int i {0}; i < net.getElementQty(); i++) {
-		net.getElement(i+1)->setFlow(x(i));
+	// group loops, largest blocks first
+	vector<int> index (size+2, -1);
+
+	for (int i {1}; i <= noLoops; i++) {
+		b = find(block[i-1]);
+		if (index[b] < 0) {
+			index[b] = blocks.loops.size();
+			blocks.loops.push_back(vector<int> {});
+		}
+		blocks.loops[index[b]].push_back(i);
+	}
+
+	stable_sort(blocks.loops.begin(), blocks.loops.end(),
+		[](const vector<int>& a, const vector<int>& b) {
+			return a.size() > b.size();
+		});
+
+	// number elements by merged block
+	for (unsigned k {0}; k < blocks.loops.size(); k++) {
+		index[find(block[blocks.loops[k][0]-1])] = k;
+	}
+	for (int j {0}; j < m; j++) {
+		if (blocks.element[j] > 0)
+			blocks.element[j] = index[find(blocks.element[j])] + 1;
 	}
 }
 
-void hardyCross(const Network& net, const LoopDepot& depot)
+Status hardyCross(const Network& net, const LoopDepot& depot,
+		const int& threads, ostream* log)
 	// compute steady state using
 	//  the simultaneous Hardy-Cross method
 	/*
-	 * solve Ax=b;
+	 * solve Ax=b per block;
 	 *
 	 * A - d(hf_i)/d(deltaQ_j)
 	 * b - hf_i
 	 * x - deltaQ_i
+	 *
+	 * A is block diagonal over biconnected
+	 * blocks, each block is solved alone
 	 */
 {
+	Profile::Timer timer {Profile::HARDY_CROSS};
+
 	int noLoops {depot.getLNum()+depot.getPNum()};
-	int iter {0};
+	Status status {0, 0, true};
 
-	// initialize matrices
-	Eigen::MatrixXd A {noLoops, noLoops};
-	Eigen::VectorXd b {noLoops};
-	Eigen::VectorXd x {Eigen::VectorXd::Ones(noLoops)};
+	// flows of a tree follow from continuity
+	if (noLoops == 0)
+		return status;
 
-	// iterate
-	while (iter < MAX_ITER && abs(x.maxCoeff()) > EPS) {
+	Blocks blocks;
+	decompose(net, depot, blocks);
 
-		// fill matrices
-		fill(net.settings.fluid, depot, A, b);
+	int size {int(blocks.loops.size())};
+	vector<Status> statuses (size);
+	vector<vector<Iteration>> records (size);
 
-		// compute correction
-		x = A.colPivHouseholderQr().solve(b);
+	// threads solve blocks if two are large,
+	//  else assemble large blocks
+	int count {1};
+	int share {threads};
+
+	if (size > 1 && int(blocks.loops[1].size()) >= PARALLEL_LOOPS) {
+		count = min(threads, size);
+		share = 1;
+	}
 
-		// update flows through elements
-		update(depot, x);
+	// solve blocks on worker threads
+	atomic<int> next {0};
+	vector<exception_ptr> errors (size);
+
+	auto worker = [&]() {
+		for (int i {next++}; i < size; i = next++) {
+			try {
+				statuses[i] = solve(net, depot, blocks.loops[i], share,
+						log == NULL ? NULL : &records[i]);
+				for (Iteration& r : records[i])
+					r.block = i+1;
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+		}
+	};
 
-		iter++;
+	if (count > 1) {
+		vector<thread> pool;
+		for (int i {0}; i < count; i++) {
+			pool.push_back(thread {worker});
+		}
+		for (thread& t : pool) {
+			t.join();
+		}
+	}
+	else {
+		worker();
 	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e)
+			rethrow_exception(e);
+	}
+
+	if (log != NULL)
+		write(*log, records);
+
+	// worst of the blocks
+	for (const Status& s : statuses) {
+		status.iterations = max(status.iterations, s.iterations);
+		status.residual = max(status.residual, s.residual);
+		status.converged = status.converged && s.converged;
+	}
+	Profile::count(Profile::HARDY_CROSS_ITERATIONS, status.iterations);
+
+	return status;
 }
 
 void computeDischarge(const Network& net)
@@ -209,61 +615,48 @@ void computeDischarge(const Network& net)
 	}
 }
 
-void computeHead(const Network& net)
+void computeHead(const Network& net, const Trees& trees)
+	// accumulate head losses from fixed head nodes
+	/*
+	 * H_start - H_end = sgn(q) * r * q^2
+	 */
 {
 	Fluid fluid {net.settings.fluid.getType()};
+	const Forest& f {trees.head};
 	double r {0};
 		// head loss coefficient
 	double q {0};
 		// flow rate
-	Node n_1;
-	Node n_2;
+	double loss {0};
+		// head loss
 	Node* n;
 	Element* e;
+	int id {0};
 
-	Eigen::MatrixXd A {net.getElementQty(), net.getNodeQty()};
-	Eigen::VectorXd b {net.getElementQty()};
+	// total head
+	vector<double> x (net.getNodeQty(), 0);
 
-	// fill A
-	for (int i {0}; i < A.rows(); i++) {
-		for (int j {0}; j < A.cols(); j++) {
-			A(i, j) = 0;
+	for (int i : f.order) {
+		// roots are fixed
+		if (f.parent[i-1] == 0) {
+			x[i-1] = net.getNode(i)->getHead();
+			continue;
 		}
-	}
 
-	// fill matrices
-	for (int i {0}; i < A.rows(); i++) {
 		// assign
-		e = net.getElement(i+1);
+		e = net.getElement(f.parent[i-1]);
 		r = e->computeHeadLossC(fluid);
 		q = e->getFlow();
-		n_1 = e->getStart();
-		n_2 = e->getEnd();
-
-		// fill head loss matrix
-		b(i) = signum(q) * r * pow(q, 2);
-
-		// fill coefficient matrix
-
-		if (n_1.getHead() != 0) {
-			b(i) -= n_1.getHead();
-		}
-		else {
-			A(i, n_1.getId()-1) = 1;
-		}
-
-		if (n_2.getHead() != 0) {
-			b(i) += n_2.getHead();
-		}
-		else {
-			A(i, n_2.getId()-1) = -1;
-		}
+		loss = signum(q) * r * pow(q, 2);
+		id = f.from[i-1];
 
+		// going down or up the element
+		if (e->getEnd().getId() == i)
+			x[i-1] = x[id-1] - loss;
+		else
+			x[i-1] = x[id-1] + loss;
 	}
 
-	// compute total head
-	Eigen::VectorXd x {A.colPivHouseholderQr().solve(b)};
-	
 	// compute static head
 	double velocityAvg {0};
 		// average velocity in node
@@ -288,8 +681,8 @@ void computeHead(const Network& net)
 		dynamic = pow(velocityAvg, 2) / (2 * GRAVITY);
 
 		// assign
-		if (n->getPressure() == 0)
-			n->setHead(x(i) - dynamic);
+		if (!n->isFixed())
+			n->setHead(x[i] - dynamic);
 	}
 }
 
@@ -301,8 +694,8 @@ void computePressure(const Network& net)
 	for (int i {1}; i <= net.getNodeQty(); i++) {
 		// assign
 		n = net.getNode(i);
-		// skip if already set
-		if (n->getPressure() != 0)
+		// skip if fixed
+		if (n->isFixed())
 			continue;
 		
 		// compute and set
@@ -326,77 +719,547 @@ Source* recastToSource(Node* n)
 	return 0;
 }
 
-void fill(const Fluid& fluid, const LoopDepot& depot,
-	Eigen::MatrixXd& A, Eigen::VectorXd& b)
+void span(const Network& net, vector<int>& roots, Forest& f,
+		const vector<bool>& closed)
+	// breadth first search from roots,
+	//  unreached nodes become roots
+	//  of further trees
 {
-	double pStart {0};
-		// starting pressure
-	double pEnd {0};
-		// ending pressure
-	Loop l;
-
-	// A is symmetric
-	for (int i {0}; i < A.rows(); i++) {
-		//assign
-		l = depot.getLoop(i+1);
-		// compute loop head loss
-		/* a positive head loss
-		 * represents a pressure drop
-		 * and a negative head loss
-		 * represents a pressure increase
-		 */
-		b(i) = -l.computeHeadLoss(fluid);
-		
-		// compute pseudoloop head loss
-		if (depot.getPNum() > 0 && i >= depot.getLNum()) {
-			// get heads
-			pStart = l.firstFree().getHead();
-			pEnd = l.lastFree().getHead();
+	f.order.clear();
+	f.parent.assign(net.getNodeQty(), 0);
+	f.from.assign(net.getNodeQty(), 0);
+	f.sign.assign(net.getNodeQty(), 0);
+
+	vector<bool> visited (net.getNodeQty(), false);
+	unsigned next {0};
+		// position of next node to expand
+	int n {0};
+	int m {0};
+	Loop* l;
+	Element* e;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// use given roots first
+		if (roots.empty()) {
+			if (visited[i-1])
+				continue;
+			roots.push_back(i);
+		}
 
-			// compute and sum
-			b(i) +=	(pStart-pEnd);
+		for (int r : roots) {
+			if (!visited[r-1]) {
+				visited[r-1] = true;
+				f.order.push_back(r);
+			}
 		}
+		roots.clear();
 
-		// compute coefficients
-		for (int j {0}; j < A.cols(); j++) {
-			// diagonal term
-			if (i == j) {
-				A(i, j) = depot.contribute(fluid, i+1);
+		// expand
+		while (next < f.order.size()) {
+			// assign
+			n = f.order[next++];
+			l = net.getNode(n)->links;
+
+			for (int j {1}; j <= l->getSize(); j++) {
+				// assign
+				e = l->getElement(j);
+				if (!closed.empty() && closed[e->getId()-1])
+					continue;
+
+				m = e->getStart().getId();
+				if (m == n)
+					m = e->getEnd().getId();
+
+				if (visited[m-1])
+					continue;
+
+				// attach
+				visited[m-1] = true;
+				f.order.push_back(m);
+				f.parent[m-1] = e->getId();
+				f.from[m-1] = n;
+				f.sign[m-1] = -l->getOrientation(j);
 			}
-			// off-diagonal terms
-			else if (i < j) {
-				A(i, j) = depot.contribute(fluid, i+1, j+1);
-				A(j, i) = A(i, j);
+		}
+	}
+}
+
+vector<double> residual(const Network& net)
+{
+	vector<double> r (net.getNodeQty(), 0);
+	Loop* l;
+
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		// assign
+		l = net.getNode(i+1)->links;
+
+		// nodal discharge
+		if (Source* s = recastToSource(net.getNode(i+1)))
+			r[i] = s->getDischarge();
+
+		// minus flows through elements
+		for (int j {1}; j <= l->getSize(); j++) {
+			r[i] -= l->getOrientation(j) * l->getElement(j)->getFlow();
+		}
+	}
+
+	return r;
+}
+
+void incidence(const Network& net, const LoopDepot& depot,
+		const vector<int>& loops, Incidence& inc)
+{
+	// position of element in block by id-1
+	vector<int> position (net.getElementQty(), -1);
+	vector<int> count;
+	Element* e;
+
+	inc.element.clear();
+	inc.head.assign(loops.size(), 0);
+
+	for (unsigned i {0}; i < loops.size(); i++) {
+		// assign
+		LoopView l {depot.getView(loops[i])};
+
+		for (int j {1}; j <= l.getSize(); j++) {
+			e = l.getElement(j);
+			if (position[e->getId()-1] < 0) {
+				position[e->getId()-1] = inc.element.size();
+				inc.element.push_back(e);
+				count.push_back(0);
 			}
+			count[position[e->getId()-1]]++;
+		}
+
+		// fixed heads closing a pseudoloop
+		if (loops[i] > depot.getLNum())
+			inc.head[i] = l.firstFree().getHead() - l.lastFree().getHead();
+	}
+
+	// loops of element k from offset[k] to offset[k+1]
+	inc.offset.assign(inc.element.size()+1, 0);
+	for (unsigned k {0}; k < inc.element.size(); k++)
+		inc.offset[k+1] = inc.offset[k] + count[k];
+
+	inc.loop.resize(inc.offset.back());
+	inc.orientation.resize(inc.offset.back());
+
+	for (unsigned k {0}; k < inc.element.size(); k++)
+		count[k] = inc.offset[k];
+
+	for (unsigned i {0}; i < loops.size(); i++) {
+		// assign
+		LoopView l {depot.getView(loops[i])};
+
+		for (int j {1}; j <= l.getSize(); j++) {
+			int p {count[position[l.getElement(j)->getId()-1]]++};
+			inc.loop[p] = i;
+			inc.orientation[p] = l.getOrientation(j);
 		}
 	}
 }
 
-void update(const LoopDepot& depot, const Eigen::VectorXd& x)
+void assemble(const Fluid& fluid, const Incidence& inc, Pool& pool,
+		Eigen::VectorXd& b)
 {
-	double q {0};
-		// flow rate
-	int sign {0};
-		// sign of correction
+	vector<Eigen::VectorXd> local (pool.getSize(),
+			Eigen::VectorXd::Zero(b.rows()));
+
+	pool.run(inc.element.size(),
+		[&](const int& t, const int& first, const int& last) {
+			scatter(fluid, inc, first, last, local[t], NULL, NULL);
+		});
+
+	b = Eigen::Map<const Eigen::VectorXd> {inc.head.data(), b.rows()};
+	for (const Eigen::VectorXd& l : local)
+		b += l;
+}
+
+void assemble(const Fluid& fluid, const Incidence& inc, Pool& pool,
+		Eigen::MatrixXd& A, Eigen::VectorXd& b)
+{
+	vector<Eigen::VectorXd> local (pool.getSize(),
+			Eigen::VectorXd::Zero(b.rows()));
+	vector<Eigen::MatrixXd> localA (pool.getSize()-1);
+
+	A.setZero();
+
+	pool.run(inc.element.size(),
+		[&](const int& t, const int& first, const int& last) {
+			// the first thread scatters in place
+			Eigen::MatrixXd& M {t == 0 ? A : localA[t-1]};
+			if (t > 0)
+				M.setZero(A.rows(), A.cols());
+
+			scatter(fluid, inc, first, last, local[t], &M, NULL);
+		});
+
+	for (const Eigen::MatrixXd& M : localA)
+		A.triangularView<Eigen::Lower>() += M;
+
+	b = Eigen::Map<const Eigen::VectorXd> {inc.head.data(), b.rows()};
+	for (const Eigen::VectorXd& l : local)
+		b += l;
+}
+
+void assemble(const Fluid& fluid, const Incidence& inc, Pool& pool,
+		Eigen::SparseMatrix<double>& A, Eigen::VectorXd& b)
+{
+	vector<Eigen::VectorXd> local (pool.getSize(),
+			Eigen::VectorXd::Zero(b.rows()));
+	vector<vector<Eigen::Triplet<double>>> triplets (pool.getSize());
+
+	pool.run(inc.element.size(),
+		[&](const int& t, const int& first, const int& last) {
+			scatter(fluid, inc, first, last, local[t], NULL, &triplets[t]);
+		});
+
+	// duplicates are summed, zeros are kept so
+	//  the pattern does not change with flows
+	for (int t {1}; t < pool.getSize(); t++)
+		triplets[0].insert(triplets[0].end(),
+				triplets[t].begin(), triplets[t].end());
+	A.setFromTriplets(triplets[0].begin(), triplets[0].end());
+
+	b = Eigen::Map<const Eigen::VectorXd> {inc.head.data(), b.rows()};
+	for (const Eigen::VectorXd& l : local)
+		b += l;
+}
+
+Status solve(const Network& net, const LoopDepot& depot,
+		const vector<int>& loops, const int& threads,
+		vector<Iteration>* records)
+	// Newton's method on loop head losses, damped
+	//  by backtracking on the merit 1/2 |b|^2
+	/*
+	 * the Newton direction x decreases the merit
+	 * at rate -|b|^2, a step t is taken if
+	 *
+	 *   |b(t)|^2 <= (1 - 2 ARMIJO t) |b(0)|^2
+	 *
+	 * else it is halved; corrections are linear
+	 * in flows, so a step is undone in place
+	 *
+	 * A is symmetric and, away from stagnant
+	 * elements, positive definite: it is factored
+	 * by LDLT, dense or sparse by size, with the
+	 * pivoted QR left as fallback
+	 */
+{
+	const Fluid& fluid {net.settings.fluid};
+	int noLoops {int(loops.size())};
+	Status status {0, 0, false};
+	int stalls {0};
+	double best {HUGE_VAL};
+		// smallest largest residual so far
+
+	// loops of elements
+	Incidence inc;
+	incidence(net, depot, loops, inc);
+
+	// each thread assembles a share of elements,
+	//  threads are kept over the iterations
+	Pool pool {max(1, min(threads,
+			int(inc.element.size()) / PARALLEL_ELEMENTS))};
+
+	// initialize matrices, only the lower
+	//  triangle of A is assembled
+	bool sparse {noLoops >= SPARSE_LOOPS};
+	Eigen::MatrixXd A;
+	Eigen::SparseMatrix<double> S;
+	Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> factor;
+	Eigen::VectorXd b {noLoops};
+	Eigen::VectorXd x {noLoops};
+
+	if (sparse)
+		S.resize(noLoops, noLoops);
+	else
+		A.resize(noLoops, noLoops);
+
+	double merit;
+	double correction;
+	double t;
+
+	// iterate
+	while (status.iterations < MAX_ITER) {
+
+		Profile::Span span {"hardyCrossIteration"};
+
+		// fill matrices
+		if (sparse)
+			assemble(fluid, inc, pool, S, b);
+		else
+			assemble(fluid, inc, pool, A, b);
+
+		status.residual = b.cwiseAbs().maxCoeff();
+
+		if (status.residual <= net.settings.headTolerance) {
+			status.converged = true;
+			break;
+		}
+
+		// compute correction
+		if (sparse) {
+			if (status.iterations == 0)
+				factor.analyzePattern(S);
+			factor.factorize(S);
+
+			if (factor.info() == Eigen::Success)
+				x = factor.solve(b);
+			else
+				A = Eigen::MatrixXd {S};
+		}
+		if (!sparse || factor.info() != Eigen::Success)
+			x = A.selfadjointView<Eigen::Lower>().ldlt().solve(b);
+
+		if (!x.allFinite()) {
+			if (sparse)
+				A = Eigen::MatrixXd {S};
+			Eigen::MatrixXd F {A.selfadjointView<Eigen::Lower>()};
+			x = F.colPivHouseholderQr().solve(b);
+		}
+
+		correction = x.cwiseAbs().maxCoeff();
+
+		if (!isfinite(correction))
+			throw runtime_error("Steady::solve(): diverged");
+
+		// update flows through elements, backtrack
+		merit = b.squaredNorm();
+		update(inc, x);
+		t = 1;
+		assemble(fluid, inc, pool, b);
+
+		for (int k {0}; k < MAX_HALVINGS
+				&& !(b.squaredNorm() <= (1 - 2*ARMIJO*t) * merit); k++) {
+			update(inc, -t/2 * x);
+			t /= 2;
+			assemble(fluid, inc, pool, b);
+		}
+
+		if (!isfinite(b.squaredNorm()))
+			throw runtime_error("Steady::solve(): diverged");
+
+		status.iterations++;
+		status.residual = b.cwiseAbs().maxCoeff();
+
+		if (records != NULL)
+			records->push_back(Iteration {0, status.iterations, correction,
+					status.residual, t});
+
+		// converged to the resolution of flows
+		if (correction <= net.settings.flowTolerance) {
+			status.converged = true;
+			break;
+		}
+
+		// no progress left, give up unconverged
+		if (status.residual < PROGRESS * best) {
+			best = status.residual;
+			stalls = 0;
+		}
+		else if (++stalls == MAX_STALLS) {
+			break;
+		}
+	}
+
+	// the last step may have met the tolerance
+	if (status.residual <= net.settings.headTolerance)
+		status.converged = true;
+
+	return status;
+}
+
+void update(const Incidence& inc, const Eigen::VectorXd& x)
+{
+	double dq;
+		// sum of loop corrections
 	Element* e;
 
-	// for each loop
-	for (int i {1}; i <= x.rows(); i++) {
-		// for each element in loop
-		for (int j {1}; j <= depot.getLoop(i).getSize(); j++) {
-			// get an element
-			e = depot.getLoop(i).getElement(j);
-			// assign flow rate
-			q = e->getFlow();
+	// for each element
+	for (unsigned k {0}; k < inc.element.size(); k++) {
+		dq = 0;
+		for (int p {inc.offset[k]}; p < inc.offset[k+1]; p++)
+			dq += inc.orientation[p] * x(inc.loop[p]);
 
-			// determine sign
-			sign = depot.getLoop(i).getOrientation(j);
+		e = inc.element[k];
+		e->setFlow(e->getFlow() + dq);
+	}
+}
 
-			// update flow
-			e->setFlow(q+double(sign)*x(i-1));
+void scatter(const Fluid& fluid, const Incidence& inc,
+		const int& first, const int& last, Eigen::VectorXd& b,
+		Eigen::MatrixXd* A, vector<Eigen::Triplet<double>>* T)
+	/*
+	 * element k with head loss coefficient r
+	 * and flow q adds
+	 *
+	 *   -o_i r q |q|       to b_i
+	 *   o_i o_j d(r q|q|)/dq to A_ij
+	 *
+	 * for all loops i, j containing it, the
+	 * derivative includes the change of friction
+	 * with flow, see Element::computeHeadLossD()
+	 */
+{
+	Element* e;
+	double q;
+	double r;
+	double d;
+	int i;
+	int j;
+
+	for (int k {first}; k < last; k++) {
+		// assign
+		e = inc.element[k];
+		q = e->getFlow();
+		d = e->computeHeadLossD(fluid, r);
+
+		for (int p {inc.offset[k]}; p < inc.offset[k+1]; p++) {
+			b(inc.loop[p]) -= inc.orientation[p] * r*q*abs(q);
+
+			if (A == NULL && T == NULL)
+				continue;
+
+			// lower triangle, loops of an element
+			//  are in ascending order
+			for (int s {inc.offset[k]}; s <= p; s++) {
+				i = inc.loop[p];
+				j = inc.loop[s];
+
+				if (A != NULL)
+					(*A)(i, j) += inc.orientation[p]*inc.orientation[s] * d;
+				else if (T != NULL)
+					T->push_back(Eigen::Triplet<double> {i, j,
+							inc.orientation[p]*inc.orientation[s] * d});
+			}
 		}
 	}
 }
 
+void write(ostream& os, const vector<vector<Iteration>>& records)
+{
+	os << "block,iteration,correction,residual,step\n"
+		<< setprecision(9)
+		<< scientific;
+
+	for (const vector<Iteration>& block : records) {
+		for (const Iteration& r : block) {
+			os << r.block << ','
+				<< r.iteration << ','
+				<< r.correction << ','
+				<< r.residual << ','
+				<< r.step << '\n';
+		}
+	}
 }
 
+//=============================================================================
+//
+//	Pool
+
+Pool::Pool(const int& count) :
+	// a single thread runs tasks in place
+	//  and needs no error slots
+	threads {max(1, count)}, task {NULL}, range {0}, generation {0},
+	pending {0}, stop {false}, errors (threads > 1 ? threads : 0)
+{
+	for (int t {1}; t < threads; t++) {
+		workers.push_back(thread {&Pool::work, this, t});
+	}
+}
+
+Pool::~Pool()
+{
+	{
+		lock_guard<mutex> lock {guard};
+		stop = true;
+	}
+	ready.notify_all();
+
+	for (thread& t : workers) {
+		t.join();
+	}
+}
+
+int Pool::getSize() const
+{
+	return threads;
+}
+
+void Pool::run(const int& size,
+		const function<void(const int&, const int&, const int&)>& f)
+{
+	if (threads == 1) {
+		f(0, 0, size);
+		return;
+	}
+
+	// hand out the task
+	{
+		lock_guard<mutex> lock {guard};
+		task = &f;
+		range = size;
+		pending = threads-1;
+		generation++;
+	}
+	ready.notify_all();
+
+	// take the first share
+	try {
+		f(0, 0, size / threads);
+	}
+	catch (...) {
+		errors[0] = current_exception();
+	}
+
+	// wait for the other shares
+	{
+		unique_lock<mutex> lock {guard};
+		done.wait(lock, [&]() { return pending == 0; });
+		task = NULL;
+	}
+
+	// report first failure
+	for (exception_ptr& e : errors) {
+		if (e) {
+			exception_ptr first {e};
+			fill(errors.begin(), errors.end(), exception_ptr {});
+			rethrow_exception(first);
+		}
+	}
+}
+
+void Pool::work(const int& t)
+	// shares of thread t until stopped,
+	//  a task is run once per generation
+{
+	long seen {0};
+	int size;
+
+	while (true) {
+		{
+			unique_lock<mutex> lock {guard};
+			ready.wait(lock, [&]() { return stop || generation != seen; });
+			if (stop)
+				return;
+			seen = generation;
+			size = range;
+		}
+
+		try {
+			(*task)(t, size * t / threads, size * (t+1) / threads);
+		}
+		catch (...) {
+			errors[t] = current_exception();
+		}
+
+		{
+			lock_guard<mutex> lock {guard};
+			pending--;
+		}
+		done.notify_one();
+	}
+}
+
+}
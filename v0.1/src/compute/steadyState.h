@@ -3,7 +3,7 @@
 // created:	12-9-2018
 // version:	0.3
 //
-// last edit:	12-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in: steadyState.cpp
@@ -15,7 +15,16 @@
 //
 //	Headers
 
+#include<ostream>
+#include<vector>
+#include<functional>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<exception>
+
 #include"Dense"
+#include"Sparse"
 #include"Fluid.h"
 #include"Network.h"
 #include"LoopDepot.h"
@@ -26,24 +35,193 @@
 
 namespace Steady {
 
+// breadth first spanning forest
+// - vectors are indexed by node id - 1
+struct Forest {
+	std::vector<int> order;
+		// node ids in order of visit, roots first
+	std::vector<int> parent;
+		// id of element to parent node, 0 for roots
+	std::vector<int> from;
+		// id of parent node, 0 for roots
+	std::vector<int> sign;
+		// orientation of parent element at node
+};
+
+// spanning forests depending only on topology
+//  and on the set of fixed head nodes
+// - shared read-only between solves of
+//   the same network with other discharges
+struct Trees {
+	Forest continuity;
+		// one tree per connected part
+	Forest head;
+		// rooted at fixed head nodes
+};
+
+// biconnected blocks over elements open in depot
+// - fixed heads are joined by a virtual node, so
+//   pseudoloops are cycles of blocks as loops are
+// - elements of no block are bridges, their flows
+//   follow from continuity and are never corrected
+// - loops of different blocks share no element,
+//   their corrections are independent
+struct Blocks {
+	std::vector<int> element;
+		// block of element by id-1, 0 for bridges
+		//  and closed elements
+	std::vector<std::vector<int>> loops;
+		// ids of loops and pseudoloops in depot
+		//  by block-1, largest blocks first
+	int bridges;
+		// number of open elements in no block
+};
+
+// loops of a block by element, flat storage
+struct Incidence {
+	std::vector<Element*> element;
+		// elements of the block
+	std::vector<int> offset;
+		// loops of element k are from offset[k]
+		//  to offset[k+1], ascending
+	std::vector<int> loop;
+		// position of loop in block
+	std::vector<int> orientation;
+		// orientation of element in loop
+	std::vector<double> head;			// [m]
+		// difference of fixed heads closing
+		//  a pseudoloop, by position of loop
+};
+
+// Hardy-Cross iteration of a block
+struct Iteration {
+	int block;
+		// position of block in Blocks::loops + 1
+	int iteration;
+	double correction;					// [m3s-1]
+		// largest loop flow correction of
+		//  the Newton step
+	double residual;					// [m]
+		// largest loop head loss residual
+		//  after the step
+	double step;
+		// fraction of the correction applied,
+		//  below 1 if backtracked
+};
+
+// worker threads kept over the iterations
+//  of a solve
+// - the calling thread takes the first share
+//   of a task, the others wait between tasks
+class Pool {
+public:
+	// constructors
+	Pool(const int&);
+		// start workers for the given number
+		//  of threads, less the calling one
+	~Pool();
+		// stop and join workers
+	Pool(const Pool&) = delete;
+	Pool& operator= (const Pool&) = delete;
+
+	// accessors
+	int getSize() const;
+		// number of threads
+
+	// utility
+	void run(const int&,
+			const std::function<void(const int&, const int&, const int&)>&);
+		// run a task over a range split evenly
+		//  into the threads and wait for it
+		// - task takes thread, first and last
+		// - rethrows the first failure
+private:
+	void work(const int&);
+		// loop of a worker thread
+	int threads;
+		// number of threads with the caller
+	std::vector<std::thread> workers;
+	std::mutex guard;
+	std::condition_variable ready;
+		// signals a task or stop to workers
+	std::condition_variable done;
+		// signals a finished share to the caller
+	const std::function<void(const int&, const int&, const int&)>* task;
+		// current task
+	int range;
+		// size of the range of the current task
+	long generation;
+		// number of tasks run
+	int pending;
+		// workers busy on the current task
+	bool stop;
+		// workers are to return
+	std::vector<std::exception_ptr> errors;
+		// failures of the current task by thread
+};
+
+// outcome of Hardy-Cross iterations
+struct Status {
+	int iterations;
+		// largest number of iterations of a block
+	double residual;					// [m]
+		// largest loop head loss residual left
+	bool converged;
+		// false if a block stalled or ran out
+		//  of iterations, its flows are the
+		//  last iterate
+};
+
 // Main function
 
-void compute(const Network&, const LoopDepot&);
+Status compute(const Network&, const LoopDepot&, const int&,
+		std::ostream*);
 	// compute steady state for a hyraulic network
 	//  using the simultaneous Hardy-Cross method
+	// - uses up to the given number of threads,
+	//   callers on worker threads pass 1
+	// - iterations are written to the given
+	//   convergence log, if any
+Status compute(const Network&, const LoopDepot&, const Trees&,
+		const bool&, const int&, std::ostream*);
+	// compute steady state reusing spanning trees
+	// - if warm, current flows through elements
+	//   are corrected instead of recomputed
 
 // Tier 1 functions
 void assumeDischarge(const Network&);
 	// redistribute surpluss nodal discharges
 	//  to unset reservoirs if necessary
-void computeInitial(const Network&);
+void span(const Network&, Trees&);
+	// span trees of the network
+void span(const Network&, const LoopDepot&, Trees&);
+	// span trees over elements open in depot
+void balanceDischarge(const Network&);
+	// redistribute the surplus of nodal discharges
+	//  evenly to fixed head nodes
+void computeInitial(const Network&, const Trees&);
 	// make an initial guess of flows
 	//  through elements
-void hardyCross(const Network&, const LoopDepot&);
+void correctInitial(const Network&, const Trees&);
+	// correct current flows through elements
+	//  to satisfy nodal discharges
+void decompose(const Network&, const LoopDepot&, Blocks&);
+	// split loops of depot into biconnected blocks
+Status hardyCross(const Network&, const LoopDepot&, const int&,
+		std::ostream*);
 	// the simultaneous Hardy-Cross method
+	//  per block of loops
+	// - blocks are solved on up to the given
+	//   number of threads if two hold enough
+	//   loops, else large blocks are assembled
+	//   on them
+	// - iterations are written to the given
+	//   convergence log, if any
+	// - status joins those of the blocks
+	// - throws if flows are no longer finite
 void computeDischarge(const Network&);
 	// compute nodal discharges
-void computeHead(const Network&);
+void computeHead(const Network&, const Trees&);
 	// compute heads at nodes
 void computePressure(const Network&);
 	// compute pressures at nodes
@@ -52,12 +230,49 @@ void computePressure(const Network&);
 Source* recastToSource(Node* n);
 	// attempt to recast a Node*
 	//  to a Source* or Reservoir*
-void fill(const Fluid&, const LoopDepot&,
+void span(const Network&, std::vector<int>&, Forest&,
+		const std::vector<bool>& = std::vector<bool> {});
+	// span forest from given roots
+	// - skips elements closed by id-1, if given
+std::vector<double> residual(const Network&);
+	// residual of continuity at nodes
+void incidence(const Network&, const LoopDepot&, const std::vector<int>&,
+		Incidence&);
+	// find loops of elements of the given loops
+void assemble(const Fluid&, const Incidence&, Pool&,
+		Eigen::VectorXd&);
+	// assemble head loss residuals of loops
+void assemble(const Fluid&, const Incidence&, Pool&,
 		Eigen::MatrixXd&, Eigen::VectorXd&);
-	// fill coefficient and
-	//  head loss matrices
-void update(const LoopDepot&, const Eigen::VectorXd&);
-	// update flows through elements
+	// assemble lower triangle of the coefficient
+	//  matrix and residuals of loops
+	// - elements are shared out to the threads
+	//   of the pool, each with own sums
+void assemble(const Fluid&, const Incidence&, Pool&,
+		Eigen::SparseMatrix<double>&, Eigen::VectorXd&);
+	// as above, sparse
+Status solve(const Network&, const LoopDepot&, const std::vector<int>&,
+		const int&, std::vector<Iteration>*);
+	// Hardy-Cross iterations on the given loops
+	// - Newton steps are backtracked until the
+	//   squared residual decreases
+	// - assembly uses up to the given number of
+	//   threads on large blocks, started once
+	//   per solve
+	// - iterations are recorded, if given
+	// - converged once the residual or the
+	//   correction is within tolerance
+void update(const Incidence&, const Eigen::VectorXd&);
+	// update flows through elements by the
+	//  corrections of their loops
+void scatter(const Fluid&, const Incidence&, const int&, const int&,
+		Eigen::VectorXd&, Eigen::MatrixXd*,
+		std::vector<Eigen::Triplet<double>>*);
+	// add contributions of elements in a range
+	//  to residuals and to the lower triangle
+	//  of a dense or sparse matrix, if given
+void write(std::ostream&, const std::vector<std::vector<Iteration>>&);
+	// write iterations to a convergence log
 
 }
 
@@ -6,21 +6,26 @@
 // tested:
 // status:
 //
-// last edit:	16-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
 //	Headers
 
 #include<fstream>
+#include<iostream>
 #include<iomanip>
 #include<string>
 #include<cstring>
+#include<vector>
+#include<chrono>
 
 #include"transientState.h"
 #include"Element.h"
 #include"Network.h"
 #include"Settings.h"
+#include"Codec.h"
+#include"Profile.h"
 using namespace std;
 
 //=============================================================================
@@ -29,74 +34,164 @@ using namespace std;
 
 namespace Transient {
 
+static const int NUM_FIELDS {5};
+	// number of fields to output
+
 void compute(Network& net)
 {
-	static const int NUM_FIELDS {5};
-		// number of fields to output
+	Profile::Span span {"transientCompute"};
+
+	bool compressed {net.settings.output == "compressed"};
+		// write compressed streams instead of csv
+	double encodeTime {0};
+		// time spent writing compressed output [s]
 
 	// setup writing
-	ofstream* ofs = new ofstream [NUM_FIELDS * net.getElementQty()];
-	constructFiles(ofs, net.getElementQty());
+	ofstream* ofs = NULL;
+	Codec::Encoder* enc = NULL;
+
+	if (compressed) {
+		enc = new Codec::Encoder [NUM_FIELDS * net.getElementQty()];
+	}
+	else {
+		ofs = new ofstream [NUM_FIELDS * net.getElementQty()];
+		constructFiles(ofs, net);
+	}
 
 	// discretize network
 	net.discretize();
+	if (!net.lumped.isEmpty())
+		net.lumped.log(cout);
+
+	// compressed streams need mesh sizes
+	if (compressed)
+		constructFiles(enc, net);
 
 	// symulate
 	int counter {0};
 
 	while (net.settings.time < net.settings.symTime) {
-		// check events
-		net.eventHandler();
-
 		// compute
-		for (int i {1}; i <= net.getElementQty(); i++) {
-			net.getElement(i)->computeTransient(net.settings, counter);
-		}
+		step(net, counter);
 
 		// write results
-		if (counter % net.settings.writeInterval == 0)
-			write(ofs, net);
+		if (counter % net.settings.writeInterval == 0) {
+			Profile::Timer timer {Profile::WRITE, Profile::sampled(counter)};
 
-		// update
-		for (int i {1}; i <= net.getElementQty(); i++) {
-			net.getElement(i)->updateMesh();
+			if (compressed) {
+				auto start = chrono::steady_clock::now();
+				write(enc, net);
+				encodeTime += chrono::duration<double>(
+							  chrono::steady_clock::now() - start).count();
+			}
+			else {
+				write(ofs, net);
+			}
 		}
 
+		// update
+		update(net, counter);
+
 		// increment
-		net.settings.time += net.settings.timeStep;
 		counter++;
 	}
 
+	// report compression
+	if (compressed) {
+		for (int i {0}; i < NUM_FIELDS * net.getElementQty(); i++) {
+			enc[i].close();
+		}
+		logCompression(cout, enc, NUM_FIELDS * net.getElementQty(), encodeTime);
+	}
+
+	// count output
+	for (int i {0}; i < NUM_FIELDS * net.getElementQty(); i++) {
+		if (compressed)
+			Profile::count(Profile::BYTES_WRITTEN, enc[i].getBytes());
+		else
+			Profile::count(Profile::BYTES_WRITTEN, ofs[i].tellp());
+	}
+
 	delete[] ofs;
+	delete[] enc;
 }
 
 //=============================================================================
 //
 //	Tier 1 functions
 
-void constructFiles(ofstream*& ofs, const int& size)
+void step(Network& net, const int& counter)
+{
+	Profile::Timer timer {Profile::TRANSIENT, Profile::sampled(counter)};
+	Profile::count(Profile::STEPS);
+
+	// check events
+	net.eventHandler();
+
+	// junctions of lumped elements
+	net.lumped.compute(net.settings);
+
+	// compute
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		Profile::count(Profile::POINT_UPDATES,
+				net.getElement(i)->computeTransient(net.settings, counter));
+	}
+}
+
+void update(Network& net, const int& counter)
+{
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		net.getElement(i)->updateMesh(counter);
+	}
+
+	net.settings.time += net.settings.timeStep;
+}
+
+void constructFiles(ofstream*& ofs, const Network& net)
 {
+	int size {net.getElementQty()};
 	string base {"el_"};
 	string temp {""};
+	string label {""};
 
 	for (int i {0}; i < size; i++) {
-		temp = base+to_string(i+1)+"_v.csv";
+		label = to_string(net.getElement(i+1)->getLabel());
+
+		temp = base+label+"_v.csv";
 		ofs[i].open(temp.c_str());
 
-		temp = base+to_string(i+1)+"_H.csv";
+		temp = base+label+"_H.csv";
 		ofs[i+size].open(temp.c_str());
 
-		temp = base+to_string(i+1)+"_p.csv";
+		temp = base+label+"_p.csv";
 		ofs[i+2*size].open(temp.c_str());
 
-		temp = base+to_string(i+1)+"_f.csv";
+		temp = base+label+"_f.csv";
 		ofs[i+3*size].open(temp.c_str());
 
-		temp = base+to_string(i+1)+"_alpha.csv";
+		temp = base+label+"_alpha.csv";
 		ofs[i+4*size].open(temp.c_str());
 	}
 }
 
+void constructFiles(Codec::Encoder*& enc, const Network& net)
+{
+	int size {net.getElementQty()};
+	string base {"el_"};
+	string temp {""};
+	Element* e;
+
+	for (int j {0}; j < size; j++) {
+		// assign
+		e = net.getElement(j+1);
+
+		for (int i {0}; i < NUM_FIELDS; i++) {
+			temp = base+to_string(e->getLabel())+"_"+Codec::fieldName(i)+".hnc";
+			enc[j+i*size].open(temp, e->getLabel(), i, e->getMeshSize());
+		}
+	}
+}
+
 void write(ofstream*& ofs, const Network& net)
 {
 	int size {net.getElementQty()};
@@ -125,5 +220,44 @@ void write(ofstream*& ofs, const Network& net)
 	}
 }
 
+void write(Codec::Encoder*& enc, const Network& net)
+{
+	int size {net.getElementQty()};
+	vector<double> values {};
+
+	for (int i {0}; i < size; i++) {
+		for (int j {0}; j < NUM_FIELDS; j++) {
+			net.getElement(i+1)->sampleField(j, values);
+			enc[i+j*size].write(net.settings.time, values);
+		}
+	}
+}
+
+ostream& logCompression(ostream& os, const Codec::Encoder* enc,
+						const int& size, const double& seconds)
+{
+	double raw {0};
+		// size of output as plain doubles [B]
+	double written {0};
+		// size of compressed output [B]
+
+	for (int i {0}; i < size; i++) {
+		raw += enc[i].getRawBytes();
+		written += enc[i].getBytes();
+	}
+
+	os << "\nCompressed output:\n\n"
+	   << "|   Raw [B]   | Written [B] |  Ratio  | Throughput [MB/s] |\n\n"
+	   << scientific << setprecision(3)
+	   << "|  " << setw(11) << raw
+	   << "|  " << setw(11) << written
+	   << fixed
+	   << "|  " << setw(7) << (written > 0 ? raw / written : 0)
+	   << "|  " << setw(17) << (seconds > 0 ? raw / seconds / 1e6 : 0)
+	   << "|\n";
+
+	return os;
+}
+
 }
 
@@ -3,7 +3,7 @@
 // created:	16-9-2018
 // version:	0.1
 //
-// last edit:	16-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in: steadyState.cpp
@@ -16,8 +16,10 @@
 //	Headers
 
 #include<fstream>
+#include<ostream>
 
 #include"Network.h"
+#include"Codec.h"
 
 //=============================================================================
 //
@@ -32,10 +34,25 @@ void compute(Network&);
 	//  using the method of characteristics
 
 // Tier 1 functions
-void constructFiles(std::ofstream*&, const int&);
-	// construct output files
+void step(Network&, const int&);
+	// handle events and compute
+	//  values in new time step
+void update(Network&, const int&);
+	// store new values of points due
+	//  to old mesh and advance time
+void constructFiles(std::ofstream*&, const Network&);
+	// construct output files, named by
+	//  input ids of elements
+void constructFiles(Codec::Encoder*&, const Network&);
+	// construct compressed output files
+	// - mesh must be discretized
 void write(std::ofstream*&, const Network&);
 	// write results
+void write(Codec::Encoder*&, const Network&);
+	// write compressed results
+std::ostream& logCompression(std::ostream&, const Codec::Encoder*,
+							 const int&, const double&);
+	// log compression ratio and throughput
 
 }
 
@@ -3,7 +3,7 @@
 // created:	10-9-2018
 // version:	0.1
 //
-// last edit:	10-9-2018
+// last edit:	18-10-2026
 
 #ifndef CONSTANT_H
 #define CONSTANT_H
@@ -27,6 +27,9 @@ static const int MAX_ITER {1000};
 static const double RE_LAMINAR {2320};
 	// Reynolds number for
 	//  laminar to turbulent transition
+static const double RE_TURBULENT {4000};
+	// Reynolds number above which
+	//  flow is fully turbulent
 static const double GRAVITY {9.80665};
 	// gravitational acceleration
 static const double VON_KARMAN {0.4};
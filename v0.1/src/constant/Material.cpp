@@ -6,13 +6,14 @@
 // tested:	12-9-2018
 // status	working
 //
-// last edit:	12-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //
 //	Headers
 
 #include<string>
+#include<stdexcept>
 
 #include"Material.h"
 
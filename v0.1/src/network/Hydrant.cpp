@@ -0,0 +1,182 @@
+// Definitions for Hydrant structure and HydrantTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<ostream>
+#include<iomanip>
+#include<ios>
+#include<string>
+#include<vector>
+
+#include"Hydrant.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Hydrant
+
+//	Constructors ==========================================================
+Hydrant::Hydrant()
+	:id{0}, flow{0}, pressure{-1}, minimum{-1} {}
+
+//	Checks ================================================================
+bool Hydrant::isSearched() const
+{
+	return flow == 0;
+}
+
+bool Hydrant::isConstrained() const
+{
+	return pressure >= 0 || minimum >= 0;
+}
+
+//	Utility ===============================================================
+ostream& Hydrant::log(ostream& os) const
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << left
+	   << s_3
+	   << setw(5) << id
+	   << s_2
+	   << scientific
+	   << setprecision(3);
+
+	if (this->isSearched())
+		os << setw(10) << "search";
+	else
+		os << setw(10) << flow;
+
+	os << s_2;
+
+	if (pressure >= 0)
+		os << setw(10) << pressure;
+	else
+		os << setw(10) << '-';
+
+	os << s_2;
+
+	if (minimum >= 0)
+		os << setw(10) << minimum;
+	else
+		os << setw(10) << '-';
+
+	os << "|";
+
+	return os;
+}
+
+//=============================================================================
+//
+//	HydrantTable
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+HydrantTable::HydrantTable()
+	:TableReader{2}, table{} {}
+
+HydrantTable::HydrantTable(const string& file)
+	:TableReader{2}, table{}
+{
+	this->read(file);
+}
+
+HydrantTable::~HydrantTable()
+{}
+
+//	Accessors =============================================================
+int HydrantTable::getSize() const
+{
+	return table.size();
+}
+
+const Hydrant& HydrantTable::getHydrant(const int& i) const
+	// i = index
+{
+	if (i < 1 || i > this->getSize())
+		throw runtime_error("HydrantTable::getHydrant(): index");
+
+	return table[i-1];
+}
+
+//	Utility ===============================================================
+void HydrantTable::read(const string& file)
+{
+	table.clear();
+	this->parse(file);
+
+	this->validate();
+}
+
+ostream& HydrantTable::log(ostream& os) const
+{
+	os << "\nListing hydrants:\n\n";
+	os << "|   ID   |    Flow    |  Pressure  |  Minimum   |\n";
+	os << "|   [-]  |  [m3s-1]   |    [Pa]    |    [Pa]    |\n\n";
+	for (const Hydrant& h : table) {
+		h.log(os);
+		os << '\n';
+	}
+
+	return os;
+}
+
+//=============================================================================
+//	Private
+
+//	Input =================================================================
+void HydrantTable::addEntry()
+{
+	table.push_back(Hydrant {});
+}
+
+void HydrantTable::handleInput(const string& tag, const string& num)
+{
+	Hydrant& h {table.back()};
+
+	if (tag == "id") {
+		h.id = stoi(num);
+	}
+	else if (tag == "flow") {
+		h.flow = stod(num);
+	}
+	else if (tag == "pressure") {
+		h.pressure = stod(num);
+	}
+	else if (tag == "minimum") {
+		h.minimum = stod(num);
+	}
+	else {
+		throw runtime_error("HydrantTable::handleInput(): invalid");
+	}
+}
+
+void HydrantTable::validate() const
+{
+	if (table.empty())
+		throw runtime_error("HydrantTable::validate(): empty");
+
+	for (const Hydrant& h : table) {
+		if (h.id < 1)
+			throw runtime_error("HydrantTable::validate(): id");
+		else if (h.flow < 0)
+			throw runtime_error("HydrantTable::validate(): flow");
+		// a search needs a target
+		else if (h.isSearched() && !h.isConstrained())
+			throw runtime_error("HydrantTable::validate(): target");
+	}
+}
@@ -0,0 +1,114 @@
+// Declarations for Hydrant structure and HydrantTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Hydrant.cpp
+
+#ifndef HYDRANT_H
+#define HYDRANT_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<vector>
+
+#include"TableReader.h"
+
+//=============================================================================
+//
+//	Hydrant
+
+// a fire flow demand at a source node
+// - with a flow the pressures at that flow are
+//   checked against the targets
+// - without a flow the largest flow meeting
+//   the targets is searched
+struct Hydrant {
+	int id;
+		// input id of source node
+	double flow;						// [m3s-1]
+		// fire flow drawn in addition to the
+		//  discharge of the node, 0 to search
+	double pressure;					// [Pa]
+		// lowest residual pressure at the node
+		//  -1 if unconstrained
+	double minimum;						// [Pa]
+		// lowest pressure at nodes without fixed
+		//  head, -1 if unconstrained
+
+	// constructors
+	Hydrant();
+
+	// checks
+	bool isSearched() const;
+		// check if largest flow is searched
+	bool isConstrained() const;
+		// check if any pressure target is set
+
+	// utility
+	std::ostream& log(std::ostream&) const;
+		// log output
+};
+
+//=============================================================================
+//
+//	HydrantTable
+
+/* list of hydrants read from an input file
+ * - same syntax as other input files, eg.
+ *
+ * {
+ * 	{
+ * 	id:		12;
+ * 	flow:		0.016;
+ * 	pressure:	1.4e5;
+ * 	}
+ * 	{
+ * 	id:		17;
+ * 	pressure:	1.4e5;
+ * 	minimum:	1e5;
+ * 	}
+ * }
+ *
+ * - indexing starts at 1
+*/
+class HydrantTable : public TableReader {
+public:
+	// constructors
+	HydrantTable();
+	HydrantTable(const std::string&);
+		// read from file
+	~HydrantTable();
+
+	// accessors
+	int getSize() const;
+		// get number of hydrants
+	const Hydrant& getHydrant(const int&) const;
+		// get a hydrant
+
+	// utility
+	void read(const std::string&);
+		// read hydrants from file
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	std::vector<Hydrant> table;
+		// list of hydrants
+
+	// input
+	void addEntry();
+		// add an empty hydrant
+	void handleInput(const std::string&, const std::string&);
+		// store value to last hydrant
+	void validate() const;
+		// validate input
+};
+
+#endif
@@ -0,0 +1,328 @@
+// Definitions for Lumped class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<utility>
+#include<cmath>
+
+#include"Lumped.h"
+#include"Network.h"
+#include"Node.h"
+#include"Element.h"
+#include"Loop.h"
+#include"Settings.h"
+#include"Constant.h"
+#include"Utility.h"
+#include"Dense"
+using namespace std;
+
+//=============================================================================
+//
+//	Lumped
+
+//	Constructors ==========================================================
+Lumped::Lumped()
+	:junctions{}, clusters{} {}
+
+Lumped::~Lumped()
+{}
+
+//	Accessors =============================================================
+bool Lumped::isEmpty() const
+{
+	return clusters.empty();
+}
+
+//	Utility ===============================================================
+void Lumped::build(const Network& net)
+{
+	junctions.clear();
+	clusters.clear();
+
+	int n {net.getNodeQty()};
+	int m {net.getElementQty()};
+
+	bool any {false};
+	for (int i {1}; i <= m; i++) {
+		any = any || net.getElement(i)->isLumped();
+	}
+	if (!any)
+		return;
+
+	// junctions by node id-1, nodes joined by lumped
+	//  elements share a root
+	vector<int> junction (n, -1);
+	vector<int> parent (n);
+	for (int k {0}; k < n; k++)
+		parent[k] = k;
+
+	auto root = [&](int k) {
+		while (parent[k] != k)
+			k = parent[k] = parent[parent[k]];
+		return k;
+	};
+
+	Element* e;
+	Element* e_k;
+	Node* node;
+	int orient_k;
+
+	for (int i {1}; i <= m; i++) {
+		// assign
+		e = net.getElement(i);
+		if (!e->isLumped())
+			continue;
+
+		for (int k : {e->getStart().getId()-1, e->getEnd().getId()-1}) {
+			if (junction[k] != -1)
+				continue;
+
+			// assign
+			node = net.getNode(k+1);
+			junction[k] = junctions.size();
+
+			// fixed heads are kept, as are heads of
+			//  sources, see Source::computeTransient()
+			Junction j {node, {}, {}, {}, 0, node->getHead(),
+						node->isFixed() || node->getType() == Node::SOURCE};
+
+			// meshed links in order of neighbours,
+			//  see Network::assignNeighbours()
+			for (int l {1}; l <= node->links->getSize(); l++) {
+				// assign
+				e_k = node->links->getElement(l);
+				orient_k = node->links->getOrientation(l);
+
+				if (e_k->isLumped()) {
+					j.compliance += 0.5 * GRAVITY * e_k->computeArea()
+									* e_k->getLength() / pow(e_k->getCelerity(), 2);
+					continue;
+				}
+
+				j.ends.push_back(orient_k > 0 ? e_k->getMeshNode(0)
+								 : e_k->getMeshNode(e_k->getMeshSize()-1));
+				j.lengths.push_back(make_pair(e_k->getDiameter(),
+											  e_k->getSpatialStep()));
+				j.characteristic.push_back(-static_cast<double>(orient_k));
+			}
+
+			// heads of meshed ends include local losses
+			if (!j.fixed && !j.ends.empty())
+				j.head = j.ends[0]->getHead();
+
+			junctions.push_back(j);
+		}
+
+		parent[root(e->getStart().getId()-1)] = root(e->getEnd().getId()-1);
+	}
+
+	// clusters by root
+	vector<int> cluster (n, -1);
+	vector<int> position (junctions.size());
+
+	for (int k {0}; k < n; k++) {
+		if (junction[k] == -1)
+			continue;
+
+		if (cluster[root(k)] == -1) {
+			cluster[root(k)] = clusters.size();
+			clusters.push_back(Cluster {});
+		}
+
+		Cluster& c {clusters[cluster[root(k)]]};
+		position[junction[k]] = c.junctions.size();
+		c.junctions.push_back(junction[k]);
+	}
+
+	for (int i {1}; i <= m; i++) {
+		// assign
+		e = net.getElement(i);
+		if (!e->isLumped())
+			continue;
+
+		Cluster& c {clusters[cluster[root(e->getStart().getId()-1)]]};
+		c.elements.push_back(e);
+		c.start.push_back(position[junction[e->getStart().getId()-1]]);
+		c.end.push_back(position[junction[e->getEnd().getId()-1]]);
+	}
+}
+
+void Lumped::compute(const Settings& settings)
+{
+	for (Cluster& c : clusters) {
+		this->solve(settings, c);
+	}
+}
+
+ostream& Lumped::log(ostream& os) const
+{
+	string s_3 {"|   "};
+	int elements {0};
+	int largest {0};
+
+	for (const Cluster& c : clusters) {
+		elements += c.elements.size();
+		largest = max(largest, int(c.elements.size()));
+	}
+
+	os << "\nListing lumped elements:\n\n";
+	os << "|  Clusters  |  Elements  |  Junctions  |  Largest  |\n";
+	os << "|    [-]     |    [-]     |     [-]     |    [-]    |\n\n";
+	os << left
+	   << s_3
+	   << setw(9) << clusters.size()
+	   << s_3
+	   << setw(9) << elements
+	   << s_3
+	   << setw(10) << junctions.size()
+	   << s_3
+	   << setw(8) << largest
+	   << "|\n";
+
+	return os;
+}
+
+//=============================================================================
+//	Private
+
+void Lumped::solve(const Settings& settings, Cluster& cluster)
+	// continuity at junctions, outflows positive
+	//  sum (H - K_i) / P_i + C (H - H_0) / dt + sum q = 0
+	// momentum of lumped elements, friction
+	//  linearized around the current flow
+	//  L / (g A) (q - q_0) / dt = H_s - H_e - r |q_0| q
+{
+	const int size {int(cluster.junctions.size())};
+	const double dt {settings.timeStep};
+
+	Eigen::MatrixXd A {Eigen::MatrixXd::Zero(size, size)};
+	Eigen::VectorXd b {Eigen::VectorXd::Zero(size)};
+
+	vector<double> c;
+	vector<double> a;
+	vector<double> K;
+	vector<double> P;
+
+	for (int j {0}; j < size; j++) {
+		Junction& J {junctions[cluster.junctions[j]]};
+
+		// kept
+		if (J.fixed) {
+			A(j, j) = 1;
+			b(j) = J.head;
+			continue;
+		}
+
+		// characteristics of meshed links
+		if (!J.ends.empty()) {
+			c.clear();
+			a.clear();
+			K.clear();
+			P.clear();
+			J.ends[0]->computeTransientParameters(c, a, K, P, J.lengths, 0,
+												  J.characteristic, settings);
+
+			for (unsigned i {0}; i < K.size(); i++) {
+				A(j, j) += 1 / P[i];
+				b(j) += K[i] / P[i];
+			}
+		}
+
+		// compliance
+		A(j, j) += J.compliance / dt;
+		b(j) += J.compliance * J.head / dt;
+	}
+
+	// inertance
+	const int elements {int(cluster.elements.size())};
+	vector<double> k (elements);
+		// g A dt / L
+	vector<double> D (elements);
+		// 1 + k r |q_0|
+	Element* e;
+	int s;
+	int t;
+
+	for (int i {0}; i < elements; i++) {
+		// assign
+		e = cluster.elements[i];
+		s = cluster.start[i];
+		t = cluster.end[i];
+
+		k[i] = GRAVITY * e->computeArea() * dt / e->getLength();
+		D[i] = 1 + k[i] * e->computeHeadLossC(settings.fluid) * abs(e->getFlow());
+
+		// q = (q_0 + k (H_s - H_e)) / D
+		if (!junctions[cluster.junctions[s]].fixed) {
+			A(s, s) += k[i] / D[i];
+			A(s, t) -= k[i] / D[i];
+			b(s) -= e->getFlow() / D[i];
+		}
+		if (!junctions[cluster.junctions[t]].fixed) {
+			A(t, t) += k[i] / D[i];
+			A(t, s) -= k[i] / D[i];
+			b(t) += e->getFlow() / D[i];
+		}
+	}
+
+	Eigen::VectorXd x {A.partialPivLu().solve(b)};
+
+	if (!x.allFinite())
+		throw runtime_error("Lumped::solve(): junction heads");
+
+	// junctions, meshed links compute their
+	//  velocities from the head
+	for (int j {0}; j < size; j++) {
+		Junction& J {junctions[cluster.junctions[j]]};
+		if (J.fixed)
+			continue;
+
+		J.head = x(j);
+		for (Node* n : J.ends) {
+			n->setHead(J.head);
+			n->computePressure(settings.fluid);
+		}
+	}
+
+	// elements, ends are written as their mesh
+	double q;
+	double v;
+	Node* n;
+
+	for (int i {0}; i < elements; i++) {
+		// assign
+		e = cluster.elements[i];
+		s = cluster.start[i];
+		t = cluster.end[i];
+
+		q = (e->getFlow() + k[i] * (x(s) - x(t))) / D[i];
+		e->setFlow(q);
+		v = e->computeVelocity();
+
+		for (int j : {0, 1}) {
+			// assign
+			n = e->getMeshNode(j);
+
+			n->setHead(junctions[cluster.junctions[j == 0 ? s : t]].head);
+			n->computePressure(settings.fluid);
+			n->setVelocity(v);
+			n->setUpstreamVelocity(v);
+			n->setDownstreamVelocity(v);
+		}
+	}
+}
@@ -0,0 +1,105 @@
+// Declarations for Lumped class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Lumped.cpp
+
+#ifndef LUMPED_H
+#define LUMPED_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<utility>
+#include<vector>
+
+#include"Node.h"
+#include"Element.h"
+#include"Settings.h"
+
+class Network;
+
+//=============================================================================
+//
+//	Lumped
+
+/* elements of a discretized network solved as lumped
+ *  inertances and compliances at their junctions,
+ *  see Network::discretize()
+ * - lumped elements are not meshed, their mesh holds
+ *   only their ends for output
+ * - lumped elements sharing a junction form a cluster,
+ *   heads of its junctions and flows of its elements
+ *   are solved together, implicit in both
+ * - a junction takes the characteristics of its meshed
+ *   links and half of the compliance of each lumped
+ *   link, g * A * L / c^2, fixed heads are kept
+ * - meshed links take the head of the junction as
+ *   a head boundary, see Element::computeTransient()
+*/
+class Lumped {
+public:
+	// constructors
+	Lumped();
+	~Lumped();
+
+	// accessors
+	bool isEmpty() const;
+		// check if no element is lumped
+
+	// utility
+	void build(const Network&);
+		// form clusters of lumped elements
+		// - network must be discretized
+	void compute(const Settings&);
+		// advance clusters by one time step
+		//  of settings
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	struct Junction {
+		Node* node;
+			// node of network
+		std::vector<Node*> ends;
+			// mesh ends of meshed links, the
+			//  first solves characteristics
+		std::vector<std::pair<double, double>> lengths;
+			// diameter, spatialStep of meshed
+			//  links, in order of neighbours
+		std::vector<double> characteristic;
+			// characteristics of meshed links
+		double compliance;				// [m2]
+			// half of the compliance of
+			//  lumped links
+		double head;					// [m]
+			// current head
+		bool fixed;
+			// head kept by the node
+	};
+	struct Cluster {
+		std::vector<int> junctions;
+			// positions in junctions
+		std::vector<Element*> elements;
+			// lumped elements
+		std::vector<int> start;
+			// position of start in cluster
+		std::vector<int> end;
+			// position of end in cluster
+	};
+
+	std::vector<Junction> junctions;
+		// junctions of lumped elements
+	std::vector<Cluster> clusters;
+		// connected lumped elements
+
+	void solve(const Settings&, Cluster&);
+		// advance cluster by one time step
+};
+
+#endif
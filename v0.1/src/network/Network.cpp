@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -18,14 +18,27 @@
 #include<string>
 #include<cfloat>
 #include<cmath>
+#include<vector>
+#include<algorithm>
 
 #include"Network.h"
 #include"Node.h"
 #include"Loop.h"
 #include"Fluid.h"
 #include"Settings.h"
+#include"Profile.h"
 using namespace std;
 
+//=============================================================================
+//
+//	Constants
+
+static const int MAX_RATE {1024};
+	// largest rate class of multirate stepping
+static const double MAX_DRIFT {0.01};
+	// largest relative error of the wave travel
+	//  time of an element in a rate class
+
 //=============================================================================
 //
 //	Network
@@ -35,16 +48,74 @@ using namespace std;
 
 //	Constructors ==========================================================
 Network::Network()
-	:settings{}, nodeListSize{0}, elementListSize{0},
-	nodeList{NULL}, elementList{NULL}
+	:settings{}, skeleton{}, lumped{}, arena{}, nodeListSize{0},
+	elementListSize{0}, nodeList{NULL}, elementList{NULL}
 {
 	// parse input
-	this->read();
+	{
+		Profile::Timer timer {Profile::READ};
+		this->read();
+	}
+
+	// reduce before solving
+	if (settings.skeleton)
+		this->skeletonize();
+
+	// reorder for locality
+	if (settings.ordering == "rcm")
+		this->renumber();
 
 	// form node links
 	this->link();
 }
 
+Network::Network(const Network& net)
+	:settings{net.settings}, skeleton{}, lumped{}, arena{},
+	nodeListSize{net.nodeListSize}, elementListSize{net.elementListSize},
+	nodeList{NULL}, elementList{NULL}
+{
+	// mesh nodes are not copied
+	for (int i {0}; i < elementListSize; i++) {
+		if (net.elementList[i]->getMeshSize() != 0)
+			throw runtime_error("Network::Network(): discretized");
+	}
+
+	// copy nodes
+	Node* none {NULL};
+	nodeList = new Node* [nodeListSize];
+	for (int i {0}; i < nodeListSize; i++) {
+		// allocate defined in Node.h
+		allocate(nodeList[i], net.nodeList[i], arena);
+		*nodeList[i] = *net.nodeList[i];
+
+		// reset references to original
+		nodeList[i]->links = NULL;
+		nodeList[i]->setNeighbour(none);
+	}
+
+	// copy elements and rebind
+	elementList = new Element* [elementListSize];
+	for (int i {0}; i < elementListSize; i++) {
+		elementList[i] = arena.make<Element>(*net.elementList[i]);
+		elementList[i]->setStart(nodeList[net.elementList[i]->getStart().getId()-1]);
+		elementList[i]->setEnd(nodeList[net.elementList[i]->getEnd().getId()-1]);
+	}
+
+	// copy links
+	Loop* l;
+	for (int i {0}; i < nodeListSize; i++) {
+		// assign
+		l = net.nodeList[i]->links;
+
+		nodeList[i]->links = new Loop {l->getSize()};
+		for (int j {1}; j <= l->getSize(); j++) {
+			nodeList[i]->links->store(
+				elementList[l->getElement(j)->getId()-1],
+				l->getOrientation(j));
+		}
+	}
+}
+
 Network::~Network()
 {
 	// delete node links
@@ -53,6 +124,8 @@ Network::~Network()
 	this->deleteNodeList();
 	// delete elements
 	this->deleteElementList();
+	// release nodes, elements and mesh
+	arena.release();
 }
 
 //	Accessors =============================================================
@@ -140,10 +213,12 @@ void Network::eventHandler() const
 
 void Network::discretize()
 {
+	Profile::Timer timer {Profile::DISCRETIZE};
+
 	// find smallest element
 	double small {DBL_MAX};
 		// length of smalles
-	int id {0};
+	int id {-1};
 		// id-1 of smallest
 	Element* e;
 
@@ -153,11 +228,21 @@ void Network::discretize()
 		// compute
 		e->computeCelerity(settings);
 
+		// short elements away from valves are
+		//  lumped, see Lumped.h
+		e->setLumped(e->getLength() < settings.lumped
+					 && e->getStart().getType() != Node::VALVE
+					 && e->getEnd().getType() != Node::VALVE);
+		if (e->isLumped())
+			continue;
+
 		if (e->getLength() < small) {
 			small = e->getLength();
 			id = i;
 		}
 	}
+	if (id == -1)
+		throw runtime_error("Network::discretize(): all elements lumped");
 
 	// compute time step
 	double TEMPORAL_INCR {1e-9};
@@ -177,6 +262,8 @@ void Network::discretize()
 	for (int i {0}; i < elementListSize; i++) {
 		// assign
 		e = elementList[i];
+		if (e->isLumped())
+			continue;
 		beta = e->computeMomentumCorrection(settings);
 		
 		// compute specific spatial step
@@ -199,16 +286,48 @@ void Network::discretize()
 		throw runtime_error("Network::discretize(): timeStep < 0");
 	
 	// discretize elements
+	int rate;
+		// rate class of element
+	double natural;
+		// segments of element at Courant number 1
 	for (int i {0}; i < elementListSize; i++) {
 		// assign
 		e = elementList[i];
+		rate = 1;
 
 		// set spatial step
 		specificSpatial = e->getLength() / ceil(e->getLength() / spatial);
+
+		// lumped, mesh holds its ends
+		if (e->isLumped()) {
+			specificSpatial = e->getLength();
+		}
+		// largest class that keeps the minimum number of
+		//  segments, and two so that points next to the
+		//  ends are internal, segments as long as its
+		//  Courant limit allows
+		// - a wave crosses a segment per step of the
+		//   element, classes that cut the travel time
+		//   by more than a time step and MAX_DRIFT
+		//   are not taken
+		else if (settings.multirate) {
+			beta = e->computeMomentumCorrection(settings);
+			natural = e->getLength() * sqrt(beta) / (e->getCelerity() * temporal);
+
+			while (2 * rate <= MAX_RATE
+				&& floor(natural / (2 * rate)) >= max(settings.discretization, 2.0)
+				&& natural - 2 * rate * floor(natural / (2 * rate))
+				   <= max(1.0, MAX_DRIFT * natural))
+				rate *= 2;
+
+			specificSpatial = e->getLength() / max(floor(natural / rate), 1.0);
+		}
+		e->setRate(rate);
 		e->setSpatialStep(specificSpatial);
 		
 		// discretize
-		e->discretize();
+		e->discretize(arena);
+		Profile::count(Profile::MESH_POINTS, e->getMeshSize());
 	}
 
 	// map values
@@ -219,11 +338,17 @@ void Network::discretize()
 		e->mapFields(settings);
 	}
 
-	// local loss correction
+	// local loss correction, corrections depend on
+	//  order of elements, visit in input order
+	vector<Element*> inputOrder (elementList, elementList+elementListSize);
+	sort(inputOrder.begin(), inputOrder.end(),
+		 [](const Element* a, const Element* b)
+		 { return a->getLabel() < b->getLabel(); });
+
 	Node* n;
 	for (int i {0}; i < elementListSize; i++) {
 		// assign
-		e = elementList[i];
+		e = inputOrder[i];
 		for (int j {0}; j < 2; j++) {
 			if (j == 0) {
 				n = e->getMeshNode(0);
@@ -245,6 +370,9 @@ void Network::discretize()
 
 	// assign node neighbours
 	this->assignNeighbours();
+
+	// form clusters of lumped elements
+	lumped.build(*this);
 }
 
 ostream& Network::log(ostream& os) const
@@ -257,6 +385,10 @@ ostream& Network::log(ostream& os) const
 	settings.log(os);
 	os << '\n';
 
+	// list reduction
+	if (skeleton.isReduced())
+		skeleton.log(os);
+
 	// list nodes
 	os << "\nListing nodes:\n\n";
 	os << "|   ID   |  Type  |    Head    |  Pressure  |   Elev   |";
@@ -271,7 +403,7 @@ ostream& Network::log(ostream& os) const
 	// list node links
 	os << "\nListing node links:\n\n";
 	for (int i {0}; i < nodeListSize; i++) {
-		os << "Node [ " << i+1 << " ] :\t";
+		os << "Node [ " << nodeList[i]->getLabel() << " ] :\t";
 		nodeList[i]->links->log(os);
 		os << '\n';
 	}
@@ -310,21 +442,15 @@ int Network::getAvailableElement() const
 }
 
 void Network::deleteNodeList()
-	// delete nodes and list
+	// delete list
 {
-	for (int i {0}; i < nodeListSize; i++) {
-		delete nodeList[i];
-	}
 	delete[] nodeList;
 	nodeList = NULL;
 }
 
 void Network::deleteElementList()
-	// delete elements and list
+	// delete list
 {
-	for (int i {0}; i < elementListSize; i++) {
-		delete elementList[i];
-	}
 	delete[] elementList;
 	elementList = NULL;
 }
@@ -341,13 +467,13 @@ void Network::initializeNodeList()
 	// fill node list with dummy nodes
 {
 	for (int i {0}; i < nodeListSize; i++)
-		nodeList[i] = new Node {};
+		nodeList[i] = arena.make<Node>();
 }
 
 void Network::initializeElementList()
 {
 	for (int i {0}; i < elementListSize; i++)
-		elementList[i] = new Element {};
+		elementList[i] = arena.make<Element>();
 }
 
 void Network::link() const
@@ -377,6 +503,485 @@ void Network::link() const
 	}
 }
 
+void Network::skeletonize()
+	// collapse short elements, drain dead-end branches
+	//  and merge series chains, in that order
+	/*
+	 * input nodes and elements are not modified, nodes
+	 * and elements that change are replaced by copies
+	 * in the arena carrying the same labels
+	 *
+	 * removed nodes are plain nodes or sources without
+	 * fixed head or events; their discharges move to
+	 * the node they are collapsed or drained into
+	 *
+	 * series chains pass plain nodes without loss
+	 * between elements of equal diameter, roughness,
+	 * thickness and material, the merged element is
+	 * exact for any flow
+	*/
+{
+	skeleton.store(nodeList, nodeListSize, elementList, elementListSize);
+
+	int n {nodeListSize};
+	int m {elementListSize};
+
+	// current nodes and elements, NULL if removed,
+	//  positions are id-1
+	vector<Node*> node (nodeList, nodeList+n);
+	vector<Element*> element (elementList, elementList+m);
+	int remaining {m};
+
+	// incident elements
+	vector<vector<int>> links (n);
+	int s;
+	int t;
+
+	for (int j {0}; j < m; j++) {
+		s = element[j]->getStart().getId()-1;
+		t = element[j]->getEnd().getId()-1;
+
+		// loops on a node are kept as they are
+		if (s == t)
+			continue;
+
+		links[s].push_back(j);
+		links[t].push_back(j);
+	}
+
+	// other end of element
+	auto other = [&element](const int& j, const int& k) {
+		int a {element[j]->getStart().getId()-1};
+		return a == k ? element[j]->getEnd().getId()-1 : a;
+	};
+	auto detach = [&links](const int& k, const int& j) {
+		links[k].erase(find(links[k].begin(), links[k].end(), j));
+	};
+	// node carries no fixed head, event or valve
+	auto removable = [&node](const int& k) {
+		Node* x {node[k]};
+		return x != NULL && !x->isFixed()
+			&& (x->getType() == Node::NODE || x->getType() == Node::SOURCE)
+			&& x->getEventStart() == -1 && x->getEventEnd() == -1;
+	};
+	auto discharge = [&node](const int& k) {
+		Source* x {down_cast<Source>(node[k])};
+		return x != NULL ? x->getDischarge() : 0;
+	};
+	// copy an input element before changing it
+	auto copy = [&](const int& j) {
+		if (element[j] == elementList[j])
+			element[j] = arena.make<Element>(*element[j]);
+		return element[j];
+	};
+	// bind incident elements to current node
+	auto rebind = [&](const int& k) {
+		Element* e;
+		for (int j : links[k]) {
+			e = copy(j);
+			if (e->getStart().getId() == k+1)
+				e->setStart(node[k]);
+			else
+				e->setEnd(node[k]);
+		}
+	};
+	// move discharge of node k to node l
+	auto drain = [&](const int& k, const int& l) {
+		double d {discharge(k)};
+		if (d == 0)
+			return true;
+
+		// fixed heads balance their discharge,
+		//  a zero discharge reads as unset
+		Node* x {node[l]};
+		if (x->isFixed() || d + discharge(l) == 0
+		 || (x->getType() != Node::NODE && x->getType() != Node::SOURCE))
+			return false;
+
+		Source* y;
+		if (x->getType() == Node::SOURCE) {
+			// copy
+			if (x == nodeList[l]) {
+				allocate(node[l], x, arena);
+				*node[l] = *x;
+			}
+			y = down_cast<Source>(node[l]);
+		}
+		else {
+			// promote to source
+			y = arena.make<Source>();
+			y->setId(x->getId());
+			y->setHead(x->getHead());
+			y->setPressure(x->getPressure());
+			y->setElevation(x->getElevation());
+			y->setLoss(x->getLoss());
+			y->setEventStart(x->getEventStart());
+			y->setEventEnd(x->getEventEnd());
+			node[l] = y;
+		}
+
+		y->setDischarge(d + discharge(l));
+		rebind(l);
+		return true;
+	};
+
+	// collapse short elements, shortest first
+	vector<int> order;
+	for (int j {0}; j < m; j++) {
+		if (element[j]->getLength() < settings.collapse)
+			order.push_back(j);
+	}
+	stable_sort(order.begin(), order.end(),
+				[&element](const int& a, const int& b)
+				{ return element[a]->getLength() < element[b]->getLength(); });
+
+	int u;
+	int v;
+
+	for (int j : order) {
+		s = element[j]->getStart().getId()-1;
+		t = element[j]->getEnd().getId()-1;
+
+		if (s == t)
+			continue;
+
+		// v is removed, u keeps its head
+		if (removable(t) && (!removable(s) || links[t].size() <= links[s].size())) {
+			u = s;
+			v = t;
+		}
+		else if (removable(s)) {
+			u = t;
+			v = s;
+		}
+		else {
+			continue;
+		}
+
+		// local losses of moved elements are kept
+		if (node[u]->getLoss() != node[v]->getLoss())
+			continue;
+
+		// parallel elements would close on a node
+		bool parallel {false};
+		for (int i : links[v]) {
+			if (i != j && other(i, v) == u)
+				parallel = true;
+		}
+		if (parallel || !drain(v, u))
+			continue;
+
+		// remove
+		detach(u, j);
+		detach(v, j);
+		element[j] = NULL;
+		remaining--;
+
+		// move to u
+		Element* e;
+		for (int i : links[v]) {
+			e = copy(i);
+			if (e->getStart().getId() == v+1)
+				e->setStart(node[u]);
+			else
+				e->setEnd(node[u]);
+			links[u].push_back(i);
+		}
+		links[v].clear();
+		node[v] = NULL;
+
+		skeleton.markNode(v+1, Skeleton::COLLAPSED);
+		skeleton.markElement(j+1, Skeleton::COLLAPSED);
+	}
+
+	// drain dead-end branches from their leaves
+	vector<int> queue;
+	for (int k {0}; k < n; k++) {
+		if (removable(k) && links[k].size() == 1)
+			queue.push_back(k);
+	}
+
+	int j;
+
+	for (unsigned i {0}; i < queue.size() && remaining > 1; i++) {
+		// assign
+		v = queue[i];
+		if (node[v] == NULL || links[v].size() != 1)
+			continue;
+		j = links[v][0];
+		u = other(j, v);
+
+		if (!drain(v, u))
+			continue;
+
+		// remove
+		detach(u, j);
+		links[v].clear();
+		element[j] = NULL;
+		node[v] = NULL;
+		remaining--;
+
+		skeleton.markNode(v+1, Skeleton::BRANCH);
+		skeleton.markElement(j+1, Skeleton::BRANCH);
+
+		if (removable(u) && links[u].size() == 1)
+			queue.push_back(u);
+	}
+
+	// merge series chains
+	auto passable = [&](const int& k) {
+		if (!removable(k) || node[k]->getType() != Node::NODE
+		 || node[k]->getLoss() != 0 || links[k].size() != 2)
+			return false;
+
+		Element* a {element[links[k][0]]};
+		Element* b {element[links[k][1]]};
+		return a->getDiameter() == b->getDiameter()
+			&& a->getRoughness() == b->getRoughness()
+			&& a->getThickness() == b->getThickness()
+			&& a->getMaterial().getModulus() == b->getMaterial().getModulus();
+	};
+
+	vector<bool> visited (n, false);
+	vector<int> chain;
+		// elements from terminal a to terminal b
+	vector<int> passed;
+		// nodes passed by chain
+	int a;
+	int b;
+
+	// walk from node k through element j to a terminal,
+	//  returns terminal, k if the chain closes
+	auto walk = [&](const int& k, int j, vector<int>& list) {
+		int c {other(j, k)};
+		list.push_back(j);
+
+		while (c != k && passable(c)) {
+			passed.push_back(c);
+			j = links[c][0] == j ? links[c][1] : links[c][0];
+			list.push_back(j);
+			c = other(j, c);
+		}
+		return c;
+	};
+
+	for (int k {0}; k < n; k++) {
+		if (visited[k] || !passable(k))
+			continue;
+
+		vector<int> left;
+		chain.clear();
+		passed.assign(1, k);
+
+		a = walk(k, links[k][0], left);
+		b = a == k ? k : walk(k, links[k][1], chain);
+
+		for (int c : passed)
+			visited[c] = true;
+
+		// closed chains would merge into a loop on a node
+		if (a == b)
+			continue;
+
+		chain.insert(chain.begin(), left.rbegin(), left.rend());
+
+		// merged element takes the label of its first
+		//  element and keeps its orientation
+		int first {chain.front()};
+		double length {0};
+
+		for (int i : chain) {
+			length += element[i]->getLength();
+			skeleton.markElement(i+1, Skeleton::SERIES);
+		}
+
+		Element* e {arena.make<Element>(*element[first])};
+		e->setLength(length);
+		if (e->getStart().getId() == a+1)
+			e->setEnd(node[b]);
+		else
+			e->setStart(node[b]);
+
+		// remove
+		for (int c : passed) {
+			links[c].clear();
+			node[c] = NULL;
+			skeleton.markNode(c+1, Skeleton::SERIES);
+		}
+		for (int i : chain) {
+			element[i] = NULL;
+		}
+		element[first] = e;
+		replace(links[b].begin(), links[b].end(), chain.back(), first);
+	}
+
+	// compact
+	vector<Node*> keptNodes;
+	vector<Element*> keptElements;
+
+	for (Node* x : node) {
+		if (x != NULL)
+			keptNodes.push_back(x);
+	}
+	for (Element* x : element) {
+		if (x != NULL)
+			keptElements.push_back(x);
+	}
+
+	nodeListSize = keptNodes.size();
+	elementListSize = keptElements.size();
+
+	delete[] nodeList;
+	nodeList = new Node* [nodeListSize];
+	for (int i {0}; i < nodeListSize; i++) {
+		nodeList[i] = keptNodes[i];
+		nodeList[i]->renumber(i+1);
+	}
+
+	delete[] elementList;
+	elementList = new Element* [elementListSize];
+	for (int i {0}; i < elementListSize; i++) {
+		elementList[i] = keptElements[i];
+		elementList[i]->renumber(i+1);
+	}
+
+	skeleton.setReducedSize(nodeListSize, elementListSize);
+}
+
+void Network::renumber()
+	// reverse Cuthill-McKee, George and Liu
+	//  pseudo-peripheral starting nodes
+{
+	// adjacency, positions are id-1
+	vector<vector<int>> adjacent (nodeListSize);
+	int s;
+	int e;
+
+	for (int i {0}; i < elementListSize; i++) {
+		s = elementList[i]->getStart().getId()-1;
+		e = elementList[i]->getEnd().getId()-1;
+
+		adjacent[s].push_back(e);
+		adjacent[e].push_back(s);
+	}
+
+	// visit neighbours by increasing degree,
+	//  ties by input order
+	auto lower = [&adjacent](const int& a, const int& b) {
+		if (adjacent[a].size() != adjacent[b].size())
+			return adjacent[a].size() < adjacent[b].size();
+		return a < b;
+	};
+	for (vector<int>& a : adjacent)
+		sort(a.begin(), a.end(), lower);
+
+	vector<int> order;
+		// Cuthill-McKee order
+	vector<int> level (nodeListSize, -1);
+		// breadth first level, -1 if unreached
+	vector<bool> placed (nodeListSize, false);
+		// node is in order
+	vector<int> queue;
+		// breadth first queue
+
+	// breadth first search, returns eccentricity
+	//  of root, queue holds the component
+	auto search = [&](const int& root) {
+		for (int n : queue)
+			level[n] = -1;
+		queue.assign(1, root);
+		level[root] = 0;
+
+		for (unsigned i {0}; i < queue.size(); i++) {
+			for (int n : adjacent[queue[i]]) {
+				if (level[n] == -1) {
+					level[n] = level[queue[i]]+1;
+					queue.push_back(n);
+				}
+			}
+		}
+		return level[queue.back()];
+	};
+
+	order.reserve(nodeListSize);
+
+	for (int i {0}; i < nodeListSize; i++) {
+		if (placed[i])
+			continue;
+
+		// pseudo-peripheral root of component
+		int root {i};
+		int eccentricity {search(root)};
+		int candidate;
+
+		while (true) {
+			// lowest degree node of last level
+			candidate = queue.back();
+			for (int n : queue) {
+				if (level[n] == eccentricity && lower(n, candidate))
+					candidate = n;
+			}
+
+			if (search(candidate) <= eccentricity) {
+				search(root);
+				break;
+			}
+			root = candidate;
+			eccentricity = level[queue.back()];
+		}
+
+		// Cuthill-McKee from root
+		unsigned first {unsigned(order.size())};
+		order.push_back(root);
+		placed[root] = true;
+
+		for (unsigned j {first}; j < order.size(); j++) {
+			for (int n : adjacent[order[j]]) {
+				if (!placed[n]) {
+					placed[n] = true;
+					order.push_back(n);
+				}
+			}
+		}
+	}
+
+	// reverse
+	reverse(order.begin(), order.end());
+
+	// renumber nodes
+	Node** nodes {new Node* [nodeListSize]};
+
+	for (int i {0}; i < nodeListSize; i++) {
+		nodes[i] = nodeList[order[i]];
+		nodes[i]->renumber(i+1);
+	}
+	delete[] nodeList;
+	nodeList = nodes;
+
+	// elements by lower then higher node
+	vector<int> elements (elementListSize);
+	auto key = [this](const int& i) {
+		int a {elementList[i]->getStart().getId()};
+		int b {elementList[i]->getEnd().getId()};
+		return make_pair(min(a, b), max(a, b));
+	};
+
+	for (int i {0}; i < elementListSize; i++)
+		elements[i] = i;
+	stable_sort(elements.begin(), elements.end(),
+				[&key](const int& a, const int& b) { return key(a) < key(b); });
+
+	// renumber elements
+	Element** list {new Element* [elementListSize]};
+
+	for (int i {0}; i < elementListSize; i++) {
+		list[i] = elementList[elements[i]];
+		list[i]->renumber(i+1);
+	}
+	delete[] elementList;
+	elementList = list;
+}
+
 void Network::assignNeighbours() const
 	// assign node neighbours
 {
@@ -392,6 +997,11 @@ void Network::assignNeighbours() const
 		e = elementList[i];
 		meshSize = e->getMeshSize();
 
+		// ends of lumped elements are set
+		//  by their junctions
+		if (e->isLumped())
+			continue;
+
 		for (int j {0}; j < meshSize; j++) {
 			// assign
 			n_new = e->getMeshNode(j);
@@ -404,16 +1014,21 @@ void Network::assignNeighbours() const
 					// assign
 					e_k = n_new->links->getElement(k);
 					orient_k = n_new->links->getOrientation(k);
+
+					// lumped links are solved with
+					//  the junction
+					if (e_k->isLumped())
+						continue;
 					
 					// add neighbour node in same element
 					if (e->getId() == e_k->getId()) {
 						if (orient_k > 0) {
-							n_new->setNeighbour(e_k->getMeshOldNode(1));
-							n_old->setNeighbour(e_k->getMeshOldNode(1));
+							n_new->setNeighbour(e_k->getArrivalNode(0));
+							n_old->setNeighbour(e_k->getArrivalNode(0));
 						}
 						else {
-							n_new->setNeighbour(e_k->getMeshOldNode(e_k->getMeshSize()-2));
-							n_old->setNeighbour(e_k->getMeshOldNode(e_k->getMeshSize()-2));
+							n_new->setNeighbour(e_k->getArrivalNode(e_k->getMeshSize()-1));
+							n_old->setNeighbour(e_k->getArrivalNode(e_k->getMeshSize()-1));
 						}
 					}
 
@@ -435,11 +1050,11 @@ void Network::assignNeighbours() const
 				n_old->setNeighbour(e->getMeshOldNode(j));
 
 				// set neighbours_
-				n_new->setNeighbours(e->getMeshOldNode(j-1));
-				n_old->setNeighbours(e->getMeshOldNode(j-1));
+				n_new->setNeighbours(e->getDepartureNode(j-1));
+				n_old->setNeighbours(e->getDepartureNode(j-1));
 
-				n_new->setNeighbours(e->getMeshOldNode(j+1));
-				n_old->setNeighbours(e->getMeshOldNode(j+1));
+				n_new->setNeighbours(e->getDepartureNode(j+1));
+				n_old->setNeighbours(e->getDepartureNode(j+1));
 			}
 		}
 	}
@@ -3,7 +3,7 @@
 // created:	25-8-2018
 // version:	0.3
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 //
 //
 /* definitions in:
@@ -26,6 +26,9 @@
 #include"Node.h"
 #include"Element.h"
 #include"Settings.h"
+#include"Arena.h"
+#include"Skeleton.h"
+#include"Lumped.h"
 
 //=============================================================================
 //
@@ -33,7 +36,9 @@
 
 /* a list of all nodes in the hydraulic network
  * container for nodes and elements
- * - allocates memory and stores new nodes and elements
+ * - allocates memory and stores new nodes and elements,
+ *   nodes, elements and mesh points live in an arena
+ *   released in bulk by the destructor
  * - if list sizes are provided, node list is filled with
  *   pointers to 0 id nodes, while element list is filled
  *   with NULL pointers
@@ -43,9 +48,19 @@ class Network {
 public:
 	Settings settings;
 		// symulation settings
+	Skeleton skeleton;
+		// input nodes and elements of a
+		//  skeletonized network
+		// - empty for copies
+	Lumped lumped;
+		// elements solved at their junctions,
+		//  formed by discretize()
 
 	// constructors
 	Network();
+	Network(const Network&);
+		// deep copy of nodes, elements and links
+		// - network must not be discretized
 	~Network();
 
 	// accessors
@@ -79,6 +94,8 @@ public:
 		// log output
 	
 private:
+	Arena arena;
+		// storage of nodes, elements and mesh points
 	int nodeListSize;
 		// number of nodes
 	int elementListSize;
@@ -90,9 +107,11 @@ private:
 
 	// generation
 	void deleteNodeList();
-		// free node list memory
+		// free node list memory, nodes
+		//  are released with the arena
 	void deleteElementList();
-		// free element list memory
+		// free element list memory, elements
+		//  are released with the arena
 	void deleteLinks() const;
 		// delete node links
 	int getAvailableElement() const;
@@ -104,6 +123,17 @@ private:
 	void link() const;
 		// store element links for each node
 	void assignNeighbours() const;
+	void skeletonize();
+		// collapse short elements, drain dead-end
+		//  branches into nodal discharges and merge
+		//  series chains, see Skeleton.h
+		// - ids become positions in the reduced
+		//   network, labels keep input ids
+	void renumber();
+		// reverse Cuthill-McKee order of nodes,
+		//  elements follow their nodes
+		// - ids become positions in the new
+		//   order, labels keep input ids
 	
 	// input
 	void read();
@@ -158,10 +188,9 @@ void Network::storeNode(const int& id)
 		}
 	}
 
-	// delete old node
-	delete getNode(id);
-	// reassign
-	getNode(id) = new Type {};
+	// reassign, old node is released
+	//  with the arena
+	getNode(id) = arena.make<Type>();
 
 	// update elements
 	for (int i {1}; i <= elementListSize; i++) {
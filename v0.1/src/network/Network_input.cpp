@@ -6,7 +6,7 @@
 // tested:	12-9-2018
 // status:	working
 //
-// last edit: 	12-9-2018
+// last edit: 	18-10-2026
 
 //=============================================================================
 //	
@@ -363,11 +363,13 @@ void Network::validate(const string& file)
 			// compute head
 			if (n->getPressure() != 0) {
 				notSet = false;
+				n->setFixed(true);
 				n->computeHead(settings.fluid);
 			}
 			// compute pressure
 			else if (n->getHead() != 0) {
 				notSet = false;
+				n->setFixed(true);
 				n->computePressure(settings.fluid);
 			}
 				
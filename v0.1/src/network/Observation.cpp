@@ -0,0 +1,162 @@
+// Definitions for Observation structure and ObservationTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<ostream>
+#include<iomanip>
+#include<ios>
+#include<string>
+#include<vector>
+
+#include"Observation.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Observation
+
+//	Constructors ==========================================================
+Observation::Observation()
+	:id{0}, kind{""}, value{0}, weight{1} {}
+
+//	Checks ================================================================
+bool Observation::isPressure() const
+{
+	return kind == "pressure";
+}
+
+//	Utility ===============================================================
+ostream& Observation::log(ostream& os) const
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	os << left
+	   << s_3
+	   << setw(5) << id
+	   << s_3
+	   << setw(9) << kind
+	   << s_2
+	   << scientific
+	   << setprecision(3)
+	   << setw(10) << value
+	   << s_2
+	   << setw(10) << weight
+	   << "|";
+
+	return os;
+}
+
+//=============================================================================
+//
+//	ObservationTable
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+ObservationTable::ObservationTable()
+	:TableReader{2}, table{} {}
+
+ObservationTable::ObservationTable(const string& file)
+	:TableReader{2}, table{}
+{
+	this->read(file);
+}
+
+ObservationTable::~ObservationTable()
+{}
+
+//	Accessors =============================================================
+int ObservationTable::getSize() const
+{
+	return table.size();
+}
+
+const Observation& ObservationTable::getObservation(const int& i) const
+	// i = index
+{
+	if (i < 1 || i > this->getSize())
+		throw runtime_error("ObservationTable::getObservation(): index");
+
+	return table[i-1];
+}
+
+//	Utility ===============================================================
+void ObservationTable::read(const string& file)
+{
+	table.clear();
+	this->parse(file);
+
+	this->validate();
+}
+
+ostream& ObservationTable::log(ostream& os) const
+{
+	os << "\nListing observations:\n\n";
+	os << "|   ID   |    Kind    |   Value    |   Weight   |\n";
+	os << "|   [-]  |    [-]     |  [m], [Pa] |    [-]     |\n\n";
+	for (const Observation& o : table) {
+		o.log(os);
+		os << '\n';
+	}
+
+	return os;
+}
+
+//=============================================================================
+//	Private
+
+//	Input =================================================================
+void ObservationTable::addEntry()
+{
+	table.push_back(Observation {});
+}
+
+void ObservationTable::handleInput(const string& tag, const string& num)
+{
+	Observation& o {table.back()};
+
+	if (tag == "id") {
+		o.id = stoi(num);
+	}
+	else if (tag == "head" || tag == "pressure") {
+		// one measurement per observation
+		if (o.kind != "")
+			throw runtime_error("ObservationTable::handleInput(): "+tag);
+		o.kind = tag;
+		o.value = stod(num);
+	}
+	else if (tag == "weight") {
+		o.weight = stod(num);
+	}
+	else {
+		throw runtime_error("ObservationTable::handleInput(): invalid");
+	}
+}
+
+void ObservationTable::validate() const
+{
+	if (table.empty())
+		throw runtime_error("ObservationTable::validate(): empty");
+
+	for (const Observation& o : table) {
+		if (o.id < 1)
+			throw runtime_error("ObservationTable::validate(): id");
+		else if (o.kind == "")
+			throw runtime_error("ObservationTable::validate(): value");
+		else if (o.weight <= 0)
+			throw runtime_error("ObservationTable::validate(): weight");
+	}
+}
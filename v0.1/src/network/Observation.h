@@ -0,0 +1,105 @@
+// Declarations for Observation structure and ObservationTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Observation.cpp
+
+#ifndef OBSERVATION_H
+#define OBSERVATION_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<vector>
+
+#include"TableReader.h"
+
+//=============================================================================
+//
+//	Observation
+
+// a measured head or pressure at a node
+// - exactly one of head and pressure is set
+struct Observation {
+	int id;
+		// input id of node
+	std::string kind;
+		// head or pressure
+	double value;						// [m] or [Pa]
+		// measured value
+	double weight;
+		// weight of the residual, 1 by default
+
+	// constructors
+	Observation();
+
+	// checks
+	bool isPressure() const;
+		// check if a pressure is measured
+
+	// utility
+	std::ostream& log(std::ostream&) const;
+		// log output
+};
+
+//=============================================================================
+//
+//	ObservationTable
+
+/* list of observations read from an input file
+ * - same syntax as other input files, eg.
+ *
+ * {
+ * 	{
+ * 	id:		12;
+ * 	pressure:	3.1e5;
+ * 	}
+ * 	{
+ * 	id:		17;
+ * 	head:		41.2;
+ * 	weight:		2;
+ * 	}
+ * }
+ *
+ * - indexing starts at 1
+*/
+class ObservationTable : public TableReader {
+public:
+	// constructors
+	ObservationTable();
+	ObservationTable(const std::string&);
+		// read from file
+	~ObservationTable();
+
+	// accessors
+	int getSize() const;
+		// get number of observations
+	const Observation& getObservation(const int&) const;
+		// get a observation
+
+	// utility
+	void read(const std::string&);
+		// read observations from file
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	std::vector<Observation> table;
+		// list of observations
+
+	// input
+	void addEntry();
+		// add an empty observation
+	void handleInput(const std::string&, const std::string&);
+		// store value to last observation
+	void validate() const;
+		// validate input
+};
+
+#endif
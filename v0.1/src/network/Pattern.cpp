@@ -0,0 +1,136 @@
+// Definitions for Pattern class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<ostream>
+#include<sstream>
+#include<iomanip>
+#include<ios>
+#include<string>
+#include<vector>
+
+#include"Pattern.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Pattern
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+Pattern::Pattern()
+	:TableReader{1}, step{0}, periods{0}, multipliers{} {}
+
+Pattern::Pattern(const string& file)
+	:TableReader{1}, step{0}, periods{0}, multipliers{}
+{
+	this->read(file);
+}
+
+Pattern::~Pattern()
+{}
+
+//	Accessors =============================================================
+double Pattern::getStep() const
+{
+	return step;
+}
+
+int Pattern::getPeriods() const
+{
+	return periods;
+}
+
+double Pattern::getMultiplier(const int& i) const
+	// i = period
+{
+	if (i < 1 || i > periods)
+		throw runtime_error("Pattern::getMultiplier(): index");
+
+	return multipliers[(i-1) % multipliers.size()];
+}
+
+//	Utility ===============================================================
+void Pattern::read(const string& file)
+{
+	multipliers.clear();
+	this->parse(file);
+
+	this->validate();
+}
+
+ostream& Pattern::log(ostream& os) const
+{
+	os << "\nListing demand pattern:\n\n"
+	   << fixed
+	   << setprecision(3)
+	   << "Period length:\t" << step << " s\n"
+	   << "Periods:\t" << periods << '\n'
+	   << "Multipliers:\t";
+
+	for (unsigned i {0}; i < multipliers.size(); i++) {
+		os << multipliers[i];
+		if (i != multipliers.size()-1)
+			os << ", ";
+	}
+	os << '\n';
+
+	return os;
+}
+
+//=============================================================================
+//	Private
+
+//	Input =================================================================
+void Pattern::handleInput(const string& tag, const string& num)
+{
+	if (tag == "step") {
+		step = stod(num);
+	}
+	else if (tag == "periods") {
+		periods = stoi(num);
+	}
+	else if (tag == "multipliers") {
+		// comma separated list
+		istringstream iss {num};
+		string value;
+
+		while (getline(iss, value, ',')) {
+			if (!value.empty())
+				multipliers.push_back(stod(value));
+		}
+	}
+	else {
+		throw runtime_error("Pattern::handleInput(): invalid");
+	}
+}
+
+void Pattern::validate() const
+{
+	if (step <= 0)
+		throw runtime_error("Pattern::validate(): step");
+	else if (periods < 1)
+		throw runtime_error("Pattern::validate(): periods");
+	else if (multipliers.empty())
+		throw runtime_error("Pattern::validate(): multipliers");
+
+	// demands keep their sign, a zero demand is
+	//  kept by the steady computation
+	for (double m : multipliers) {
+		if (m < 0)
+			throw runtime_error("Pattern::validate(): multiplier");
+	}
+}
@@ -0,0 +1,79 @@
+// Declarations for Pattern class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Pattern.cpp
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<vector>
+
+#include"TableReader.h"
+
+//=============================================================================
+//
+//	Pattern
+
+/* demand pattern for an extended period simulation
+ * read from an input file, eg.
+ *
+ * {
+ * 	step:		3600;
+ * 	periods:	48;
+ * 	multipliers:	0.6, 0.5, 0.5, 0.6, 0.8, 1.1;
+ * 	multipliers:	1.3, 1.2, 1.0, 0.9, 1.0, 1.2;
+ * }
+ *
+ * - each multipliers tag appends values
+ * - the pattern repeats if periods exceed
+ *   the number of multipliers
+ * - indexing starts at 1
+*/
+class Pattern : public TableReader {
+public:
+	// constructors
+	Pattern();
+	Pattern(const std::string&);
+		// read from file
+	~Pattern();
+
+	// accessors
+	double getStep() const;
+		// get length of period
+	int getPeriods() const;
+		// get number of periods
+	double getMultiplier(const int&) const;
+		// get demand multiplier of a period
+
+	// utility
+	void read(const std::string&);
+		// read pattern from file
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	double step;						// [s]
+		// length of period
+	int periods;
+		// number of periods
+	std::vector<double> multipliers;
+		// demand multipliers
+
+	// input
+	void handleInput(const std::string&, const std::string&);
+		// store value
+	void validate() const;
+		// validate input
+};
+
+#endif
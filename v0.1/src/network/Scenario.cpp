@@ -0,0 +1,218 @@
+// Definitions for Scenario structure and ScenarioTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<ostream>
+#include<iomanip>
+#include<ios>
+#include<string>
+#include<vector>
+#include<set>
+
+#include"Scenario.h"
+#include"Network.h"
+#include"Node.h"
+#include"steadyState.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Scenario
+
+//	Constructors ==========================================================
+Scenario::Scenario()
+	:id{0}, demand{1}, level{0}, eventStart{-1}, eventEnd{-1}, celerity{0} {}
+
+//	Checks ================================================================
+bool Scenario::changesSteady() const
+{
+	return demand != 1 || level != 0;
+}
+
+//	Utility ===============================================================
+void Scenario::apply(Network& net) const
+{
+	Node* n;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		// assign
+		n = net.getNode(i);
+
+		// scale demand
+		if (Source* s = down_cast<Source>(n)) {
+			if (!s->isFixed())
+				s->setDischarge(s->getDischarge() * demand);
+		}
+		// shift fixed heads
+		if (n->isFixed() && level != 0) {
+			n->setHead(n->getHead() + level);
+			n->computePressure(net.settings.fluid);
+		}
+		// shift valve events
+		if (Valve* v = down_cast<Valve>(n)) {
+			if (eventStart >= 0)
+				v->setEventStart(eventStart);
+			if (eventEnd >= 0)
+				v->setEventEnd(eventEnd);
+			v->isValid();
+		}
+	}
+
+	// rebalance discharges at fixed head nodes,
+	//  the steady computation corrects them
+	if (this->changesSteady())
+		Steady::balanceDischarge(net);
+
+	// override celerity
+	if (celerity > 0)
+		net.settings.celerity = celerity;
+}
+
+ostream& Scenario::log(ostream& os) const
+{
+	string s_3 {"|   "};
+
+	os << left
+	   << s_3
+	   << setw(5) << id
+	   << s_3
+	   << fixed
+	   << setprecision(3)
+	   << setw(7) << demand
+	   << s_3
+	   << setw(7) << level
+	   << s_3
+	   << setw(9) << eventStart
+	   << s_3
+	   << setw(9) << eventEnd
+	   << s_3
+	   << setw(9) << celerity
+	   << "|";
+
+	return os;
+}
+
+//=============================================================================
+//
+//	ScenarioTable
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+ScenarioTable::ScenarioTable()
+	:TableReader{2}, table{} {}
+
+ScenarioTable::ScenarioTable(const string& file)
+	:TableReader{2}, table{}
+{
+	this->read(file);
+}
+
+ScenarioTable::~ScenarioTable()
+{}
+
+//	Accessors =============================================================
+int ScenarioTable::getSize() const
+{
+	return table.size();
+}
+
+const Scenario& ScenarioTable::getScenario(const int& i) const
+	// i = index
+{
+	if (i < 1 || i > this->getSize())
+		throw runtime_error("ScenarioTable::getScenario(): index");
+
+	return table[i-1];
+}
+
+//	Utility ===============================================================
+void ScenarioTable::read(const string& file)
+{
+	table.clear();
+	this->parse(file);
+
+	this->validate();
+}
+
+ostream& ScenarioTable::log(ostream& os) const
+{
+	os << "\nListing scenarios:\n\n";
+	os << "|   ID   |  Demand  |  Level   |  Ev. start  |   Ev. end   |  Celerity   |\n";
+	os << "|   [-]  |   [-]    |   [m]    |     [s]     |     [s]     |   [ms-1]    |\n\n";
+	for (const Scenario& s : table) {
+		s.log(os);
+		os << '\n';
+	}
+
+	return os;
+}
+
+//=============================================================================
+//	Private
+
+//	Input =================================================================
+void ScenarioTable::addEntry()
+{
+	table.push_back(Scenario {});
+}
+
+void ScenarioTable::handleInput(const string& tag, const string& num)
+{
+	Scenario& s {table.back()};
+
+	if (tag == "id") {
+		s.id = stoi(num);
+	}
+	else if (tag == "demand") {
+		s.demand = stod(num);
+	}
+	else if (tag == "level") {
+		s.level = stod(num);
+	}
+	else if (tag == "eventstart") {
+		s.eventStart = stod(num);
+	}
+	else if (tag == "eventend") {
+		s.eventEnd = stod(num);
+	}
+	else if (tag == "celerity") {
+		s.celerity = stod(num);
+	}
+	else {
+		throw runtime_error("ScenarioTable::handleInput(): invalid");
+	}
+}
+
+void ScenarioTable::validate() const
+{
+	if (table.empty())
+		throw runtime_error("ScenarioTable::validate(): empty");
+
+	// ids name output files
+	set<int> ids;
+
+	for (const Scenario& s : table) {
+		if (s.id < 1)
+			throw runtime_error("ScenarioTable::validate(): id");
+		else if (!ids.insert(s.id).second)
+			throw runtime_error("ScenarioTable::validate(): duplicate id "
+								+to_string(s.id));
+		else if (s.demand < 0)
+			throw runtime_error("ScenarioTable::validate(): demand");
+		else if (s.celerity < 0)
+			throw runtime_error("ScenarioTable::validate(): celerity");
+	}
+}
@@ -0,0 +1,117 @@
+// Declarations for Scenario structure and ScenarioTable class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Scenario.cpp
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<vector>
+
+#include"Network.h"
+#include"TableReader.h"
+
+//=============================================================================
+//
+//	Scenario
+
+// a set of parameter overrides applied to a copy of a network
+// - unset overrides leave the network unchanged
+struct Scenario {
+	int id;
+		// id of scenario
+	double demand;
+		// multiplier of discharges at sources
+		//  without fixed head
+	double level;						// [m]
+		// shift of heads at fixed head nodes
+	double eventStart;					// [s]
+		// start of valve events
+		//  -1 if unchanged
+	double eventEnd;					// [s]
+		// end of valve events
+		//  -1 if unchanged
+	double celerity;					// [ms-1]
+		// pressure wave celerity
+		//  0 if unchanged
+
+	// constructors
+	Scenario();
+
+	// checks
+	bool changesSteady() const;
+		// check if steady state must be recomputed
+
+	// utility
+	void apply(Network&) const;
+		// apply overrides to network
+	std::ostream& log(std::ostream&) const;
+		// log output
+};
+
+//=============================================================================
+//
+//	ScenarioTable
+
+/* list of scenarios read from an input file
+ * - same syntax as other input files, eg.
+ *
+ * {
+ * 	{
+ * 	id:		1;
+ * 	demand:		1.2;
+ * 	level:		-0.5;
+ * 	eventStart:	0.5;
+ * 	eventEnd:	0.6;
+ * 	celerity:	1200;
+ * 	}
+ * }
+ *
+ * - indexing starts at 1
+*/
+class ScenarioTable : public TableReader {
+public:
+	// constructors
+	ScenarioTable();
+	ScenarioTable(const std::string&);
+		// read from file
+	~ScenarioTable();
+
+	// accessors
+	int getSize() const;
+		// get number of scenarios
+	const Scenario& getScenario(const int&) const;
+		// get a scenario
+
+	// utility
+	void read(const std::string&);
+		// read scenarios from file
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	std::vector<Scenario> table;
+		// list of scenarios
+
+	// input
+	void addEntry();
+		// add an empty scenario
+	void handleInput(const std::string&, const std::string&);
+		// store value to last scenario
+	void validate() const;
+		// validate input
+		// - ids must be unique, they name
+		//   output files
+};
+
+#endif
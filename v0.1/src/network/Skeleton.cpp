@@ -0,0 +1,367 @@
+// Definitions for Skeleton class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<cmath>
+
+#include"Skeleton.h"
+#include"Network.h"
+#include"Node.h"
+#include"Element.h"
+#include"Loop.h"
+#include"Fluid.h"
+#include"Constant.h"
+#include"Utility.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Skeleton
+
+//	Constructors ==========================================================
+Skeleton::Skeleton()
+	:nodes{}, elements{}, nodeState{}, elementState{},
+	heads{}, pressures{}, nodeQty{0}, elementQty{0} {}
+
+Skeleton::~Skeleton()
+{}
+
+//	Accessors =============================================================
+bool Skeleton::isReduced() const
+{
+	return !nodes.empty();
+}
+
+Skeleton::State Skeleton::getNodeState(const int& i) const
+{
+	return nodeState.at(i-1);
+}
+
+Skeleton::State Skeleton::getElementState(const int& i) const
+{
+	return elementState.at(i-1);
+}
+
+//	Mutators ==============================================================
+void Skeleton::store(Node** n, const int& nodeSize,
+		Element** e, const int& elementSize)
+{
+	nodes.assign(n, n+nodeSize);
+	elements.assign(e, e+elementSize);
+	nodeState.assign(nodeSize, KEPT);
+	elementState.assign(elementSize, KEPT);
+	nodeQty = nodeSize;
+	elementQty = elementSize;
+}
+
+void Skeleton::markNode(const int& i, const State& s)
+{
+	nodeState.at(i-1) = s;
+}
+
+void Skeleton::markElement(const int& i, const State& s)
+{
+	elementState.at(i-1) = s;
+}
+
+void Skeleton::setReducedSize(const int& n, const int& e)
+{
+	nodeQty = n;
+	elementQty = e;
+}
+
+//	Utility ===============================================================
+void Skeleton::expand(const Network& net)
+{
+	if (!isReduced())
+		throw runtime_error("Skeleton::expand(): not reduced");
+
+	Fluid fluid {net.settings.fluid.getType()};
+	int n {int(nodes.size())};
+	int m {int(elements.size())};
+
+	// reduced nodes and elements by label
+	vector<Node*> node (n, NULL);
+	vector<Element*> element (m, NULL);
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		node[net.getNode(i)->getLabel()-1] = net.getNode(i);
+	}
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		element[net.getElement(i)->getLabel()-1] = net.getElement(i);
+	}
+
+	// input links, positions are id-1
+	vector<vector<int>> links (n);
+	for (int j {0}; j < m; j++) {
+		links[elements[j]->getStart().getLabel()-1].push_back(j);
+		links[elements[j]->getEnd().getLabel()-1].push_back(j);
+	}
+
+	// mean dynamic head of elements
+	auto dynamic = [](const vector<Element*>& list) {
+		double v {0};
+		for (Element* e : list)
+			v += abs(e->computeVelocity());
+		v /= list.size();
+		return pow(v, 2) / (2 * GRAVITY);
+	};
+	vector<Element*> list;
+
+	// flows of kept elements
+	vector<bool> known (m, false);
+	for (int j {0}; j < m; j++) {
+		if (element[j] == NULL)
+			continue;
+		elements[j]->setFlow(element[j]->getFlow());
+		known[j] = true;
+	}
+
+	// flows of removed elements, from leaves of
+	//  the forest inwards
+	vector<int> unknown (n, 0);
+	vector<int> queue;
+
+	for (int k {0}; k < n; k++) {
+		if (node[k] != NULL)
+			continue;
+		for (int j : links[k]) {
+			if (!known[j])
+				unknown[k]++;
+		}
+		if (unknown[k] == 1)
+			queue.push_back(k);
+	}
+
+	Element* e;
+	double sum;
+	int orient;
+	int free;
+	int other;
+
+	for (unsigned i {0}; i < queue.size(); i++) {
+		int k {queue[i]};
+		if (unknown[k] != 1)
+			continue;
+
+		// continuity, sum of outflows is discharge
+		sum = 0;
+		if (Source* s = down_cast<Source>(nodes[k]))
+			sum = s->getDischarge();
+		free = -1;
+
+		for (int j : links[k]) {
+			orient = elements[j]->getStart().getLabel() == k+1 ? 1 : -1;
+
+			if (known[j])
+				sum -= orient * elements[j]->getFlow();
+			else
+				free = j;
+		}
+
+		// assign
+		e = elements[free];
+		orient = e->getStart().getLabel() == k+1 ? 1 : -1;
+		e->setFlow(orient * sum);
+		known[free] = true;
+		unknown[k]--;
+
+		// other end
+		other = (orient > 0 ? e->getEnd() : e->getStart()).getLabel()-1;
+		if (node[other] == NULL && --unknown[other] == 1)
+			queue.push_back(other);
+	}
+
+	for (int j {0}; j < m; j++) {
+		if (!known[j])
+			throw runtime_error("Skeleton::expand(): element "
+								+to_string(j+1));
+	}
+
+	// total heads of kept nodes, as in
+	//  Steady::computeHead
+	vector<double> x (n, 0);
+	vector<bool> set (n, false);
+	queue.clear();
+
+	for (int k {0}; k < n; k++) {
+		if (node[k] == NULL)
+			continue;
+
+		x[k] = node[k]->getHead();
+		if (!node[k]->isFixed()) {
+			list.clear();
+			for (int j {1}; j <= node[k]->links->getSize(); j++)
+				list.push_back(node[k]->links->getElement(j));
+			x[k] += dynamic(list);
+		}
+
+		set[k] = true;
+		queue.push_back(k);
+	}
+
+	// total heads of removed nodes,
+	//  H_start - H_end = sgn(q) * r * q^2
+	double q;
+	double loss;
+
+	for (unsigned i {0}; i < queue.size(); i++) {
+		int k {queue[i]};
+
+		for (int j : links[k]) {
+			// assign
+			e = elements[j];
+			orient = e->getStart().getLabel() == k+1 ? 1 : -1;
+			other = (orient > 0 ? e->getEnd() : e->getStart()).getLabel()-1;
+
+			if (set[other])
+				continue;
+
+			q = e->getFlow();
+			loss = signum(q) * e->computeHeadLossC(fluid) * pow(q, 2);
+
+			x[other] = x[k] - orient * loss;
+			set[other] = true;
+			queue.push_back(other);
+		}
+	}
+
+	// static heads and pressures, the mean dynamic
+	//  head is taken over input links
+	heads.assign(n, 0);
+	pressures.assign(n, 0);
+
+	for (int k {0}; k < n; k++) {
+		if (!set[k])
+			throw runtime_error("Skeleton::expand(): node "
+								+to_string(k+1));
+
+		// fixed heads are kept
+		if (nodes[k]->isFixed()) {
+			heads[k] = node[k]->getHead();
+			pressures[k] = node[k]->getPressure();
+			continue;
+		}
+
+		list.clear();
+		for (int j : links[k])
+			list.push_back(elements[j]);
+
+		heads[k] = x[k] - dynamic(list);
+		pressures[k] = (heads[k] - nodes[k]->getElevation())
+					   * fluid.getDensity() * GRAVITY;
+	}
+}
+
+void Skeleton::write() const
+{
+	if (heads.empty())
+		throw runtime_error("Skeleton::write(): not expanded");
+
+	ofstream ofs {"skeleton_nodes.csv"};
+	if (!ofs)
+		throw runtime_error("Skeleton::write(): skeleton_nodes.csv");
+
+	ofs << "node,state,head,pressure\n"
+		<< setprecision(9)
+		<< scientific;
+
+	for (unsigned k {0}; k < nodes.size(); k++) {
+		ofs << nodes[k]->getLabel() << ','
+			<< stateName(nodeState[k]) << ','
+			<< heads[k] << ','
+			<< pressures[k] << '\n';
+	}
+
+	ofs.close();
+	ofs.open("skeleton_elements.csv");
+	if (!ofs)
+		throw runtime_error("Skeleton::write(): skeleton_elements.csv");
+
+	ofs << "element,state,flow\n";
+
+	for (unsigned j {0}; j < elements.size(); j++) {
+		ofs << elements[j]->getLabel() << ','
+			<< stateName(elementState[j]) << ','
+			<< elements[j]->getFlow() << '\n';
+	}
+}
+
+ostream& Skeleton::log(ostream& os) const
+{
+	string s_2 {"|  "};
+	string s_3 {"|   "};
+
+	// removed by stage
+	int removedNodes[4] {0, 0, 0, 0};
+	int removedElements[4] {0, 0, 0, 0};
+
+	for (State s : nodeState)
+		removedNodes[s]++;
+	for (State s : elementState)
+		removedElements[s]++;
+
+	// a chain leaves one element, labelled
+	//  as its first
+	removedElements[SERIES] = elements.size() - elementQty
+							  - removedElements[COLLAPSED]
+							  - removedElements[BRANCH];
+
+	os << "\nListing skeleton:\n\n";
+	os << "|    Stage     |  Nodes  |  Elements  |\n";
+	os << "|     [-]      |   [-]   |    [-]     |\n\n";
+
+	auto row = [&](const string& stage, const int& n, const int& e) {
+		os << left
+		   << s_3
+		   << setw(11) << stage
+		   << s_3
+		   << setw(6) << n
+		   << s_3
+		   << setw(9) << e
+		   << "|\n";
+	};
+
+	row("input", nodes.size(), elements.size());
+	for (State s : {COLLAPSED, BRANCH, SERIES})
+		row(stateName(s), -removedNodes[s], -removedElements[s]);
+	row("reduced", nodeQty, elementQty);
+
+	return os;
+}
+
+//=============================================================================
+//
+//	Utility
+
+const char* stateName(const Skeleton::State& s)
+{
+	switch (s) {
+		case Skeleton::KEPT:
+			return "kept";
+		case Skeleton::COLLAPSED:
+			return "collapsed";
+		case Skeleton::BRANCH:
+			return "branch";
+		case Skeleton::SERIES:
+			return "series";
+		default:
+			throw runtime_error("stateName(): state");
+	}
+}
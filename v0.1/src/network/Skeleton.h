@@ -0,0 +1,113 @@
+// Declarations for Skeleton class
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Skeleton.cpp
+
+#ifndef SKELETON_H
+#define SKELETON_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<vector>
+
+#include"Node.h"
+#include"Element.h"
+
+class Network;
+
+//=============================================================================
+//
+//	Skeleton
+
+/* record of a network reduced before solving,
+ *  see Network::skeletonize()
+ * - keeps the input nodes and elements, they are
+ *   not modified by the reduction and live in
+ *   the arena of the network
+ * - reduced nodes and elements keep the labels of
+ *   the input nodes and elements they replace
+ * - results of the reduced network are mapped back
+ *   by expand(), flows onto input elements that are
+ *   not part of the reduced network, heads into the
+ *   record so shared nodes keep their state
+ * - indexing by input id-1
+*/
+class Skeleton {
+public:
+	// stage of reduction that removed a node or element
+	enum State {KEPT = 0, COLLAPSED, BRANCH, SERIES};
+
+	// constructors
+	Skeleton();
+	~Skeleton();
+
+	// accessors
+	bool isReduced() const;
+		// check if input nodes were stored
+	State getNodeState(const int&) const;
+		// get state of input node
+	State getElementState(const int&) const;
+		// get state of input element
+
+	// mutators
+	void store(Node**, const int&, Element**, const int&);
+		// store input nodes and elements, all kept
+	void markNode(const int&, const State&);
+		// set state of input node
+	void markElement(const int&, const State&);
+		// set state of input element
+		// - series elements are merged into the
+		//   element labelled as the first of
+		//   their chain, it is kept
+	void setReducedSize(const int&, const int&);
+		// set number of reduced nodes and elements
+
+	// utility
+	void expand(const Network&);
+		// map the steady state of the reduced network
+		//  onto input nodes and elements
+		// - flows of removed elements follow from
+		//   continuity at removed nodes, removed
+		//   elements form a forest
+		// - heads of removed nodes follow from head
+		//   losses, all heads are less the mean
+		//   dynamic head of input links as in
+		//   Steady::computeHead
+	void write() const;
+		// write expanded state to skeleton_nodes.csv
+		//  and skeleton_elements.csv
+	std::ostream& log(std::ostream&) const;
+		// log output
+
+private:
+	std::vector<Node*> nodes;
+		// input nodes
+	std::vector<Element*> elements;
+		// input elements
+	std::vector<State> nodeState;
+		// state of input nodes
+	std::vector<State> elementState;
+		// state of input elements
+	std::vector<double> heads;			// [m]
+		// expanded heads of input nodes
+	std::vector<double> pressures;		// [Pa]
+		// expanded pressures of input nodes
+	int nodeQty;
+		// number of reduced nodes
+	int elementQty;
+		// number of reduced elements
+};
+
+//	Utility ===============================================================
+
+const char* stateName(const Skeleton::State&);
+	// name of state
+
+#endif
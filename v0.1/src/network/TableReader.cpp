@@ -0,0 +1,149 @@
+// Definitions for TableReader class
+//
+// created:	19-10-2026
+// version:	0.1
+//
+// tested:	19-10-2026
+// status:	working
+//
+// last edit:	19-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<cctype>
+#include<fstream>
+#include<string>
+
+#include"TableReader.h"
+using namespace std;
+
+//=============================================================================
+//
+//	TableReader
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+TableReader::TableReader(const int& d)
+	:depth{d}, file{""}
+{
+	if (depth < 1 || depth > 2)
+		throw runtime_error("TableReader::TableReader(): depth");
+}
+
+TableReader::~TableReader()
+{}
+
+//=============================================================================
+//	Protected
+
+//	Input =================================================================
+void TableReader::parse(const string& f)
+{
+	file = f;
+
+	ifstream ifs {file};
+	// check if file is present
+	if (!ifs)
+		throw runtime_error(file+" file missing");
+
+	// set exception mask
+	ifs.exceptions(ifs.badbit);
+
+	int open {0};
+	this->process(ifs, open);
+}
+
+void TableReader::addEntry()
+{}
+
+//=============================================================================
+//	Private
+
+//	Processing ============================================================
+void TableReader::process(ifstream& ifs, int& open)
+{
+	char ch;
+
+	while (ifs) {
+		ch = ifs.get();
+
+		// handle comment
+		if (ch == '/') {
+			string s;
+			getline(ifs, s);
+			if (s[0] != '/')
+				throw runtime_error("TableReader::process(): comment in "
+									+file);
+		}
+		// skip whitespaces
+		else if (isspace(ch)) {
+			continue;
+		}
+		// open instance, second level is an entry
+		else if (ch == '{') {
+			open++;
+			if (open > depth)
+				throw runtime_error("TableReader::process(): nesting in "
+									+file);
+
+			if (open == 2)
+				this->addEntry();
+
+			this->process(ifs, open);
+		}
+		// close instance
+		else if (ch == '}') {
+			open--;
+			if (open < 0)
+				throw runtime_error("TableReader::process(): nesting in "
+									+file);
+			return;
+		}
+		// handle tag
+		else if (isalpha(ch)) {
+			ifs.putback(ch);
+			this->processTag(ifs, open);
+		}
+	}
+	if (open != 0)
+		throw runtime_error("TableReader::process(): unclosed in "+file);
+}
+
+void TableReader::processTag(ifstream& ifs, const int& open)
+{
+	// tags are only allowed at depth
+	if (open != depth)
+		throw runtime_error("TableReader::processTag(): outside "
+							+string(depth == 2 ? "entry" : "braces")
+							+" in "+file);
+
+	string line {""};
+	getline(ifs, line);
+
+	// find delimiters
+	unsigned long pos_1 {line.find_first_of(':')};
+	unsigned long pos_2 {line.find_first_of(';')};
+
+	if (pos_1 == string::npos || pos_2 == string::npos)
+		throw runtime_error("TableReader::processTag(): syntax in "+file);
+
+	// extract and clean
+	string tag {""};
+	string num {""};
+
+	for (char c : line.substr(0, pos_1)) {
+		if (!isspace(c))
+			tag += tolower(c);
+	}
+	for (char c : line.substr(pos_1+1, pos_2-pos_1-1)) {
+		if (!isspace(c))
+			num += tolower(c);
+	}
+
+	this->handleInput(tag, num);
+}
@@ -0,0 +1,73 @@
+// Declarations for TableReader class
+//
+// created:	19-10-2026
+// version:	0.1
+//
+// last edit:	19-10-2026
+//
+// definitions in: TableReader.cpp
+
+#ifndef TABLEREADER_H
+#define TABLEREADER_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<fstream>
+#include<string>
+
+//=============================================================================
+//
+//	TableReader
+
+/* reader of small input files in the syntax of
+ * the network input, shared by scenarios,
+ * patterns, hydrants and observations
+ * - a record is a list of tags, eg.
+ *
+ * {
+ * 	{
+ * 	id:		1;
+ * 	demand:		1.2;
+ * 	}
+ * }
+ *
+ * - tags are only allowed at the depth given on
+ *   construction: 1 for a file of one record,
+ *   2 for a list of entries, each opened by a
+ *   second level brace
+ * - tags and values are lowercase and stripped
+ *   of whitespace before they are handled
+*/
+class TableReader {
+public:
+	// constructors
+	TableReader(const int&);
+		// depth of tags
+	virtual ~TableReader();
+
+protected:
+	// input
+	void parse(const std::string&);
+		// read file, throws if missing
+	virtual void addEntry();
+		// start a new entry, depth 2 only
+	virtual void handleInput(const std::string&, const std::string&) = 0;
+		// store value of tag
+
+private:
+	int depth;
+		// depth of tags
+	std::string file;
+		// name of file being read
+
+	// processing
+	void process(std::ifstream&, int&);
+		// '{' opens a processing instance
+		// '}' closes a processing instance
+	void processTag(std::ifstream&, const int&);
+		// process input tag
+};
+
+#endif
@@ -6,7 +6,7 @@
 // tested:	13-9-2018
 // status:	working
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 
 //=============================================================================
 //	Headers
@@ -15,21 +15,61 @@
 #include<string>
 #include<ostream>
 #include<cmath>
+#include<vector>
+#include<map>
+#include<utility>
+#include<algorithm>
 
+#include"Dense"
 #include"Element.h"
 #include"Loop.h"
 #include"Network.h"
 #include"Fluid.h"
 #include"LoopDepot.h"
+#include"Profile.h"
 using namespace std;
 
 //=============================================================================
-//	Constants
+//
+//	LoopView
+
+//	Constructors ==========================================================
+LoopView::LoopView(Element* const* e, const int* o, const int& s)
+	:elements{e}, orientations{o}, size{s} {}
+
+//	Accessors =============================================================
+const Node& LoopView::firstFree() const
+{
+	// start if first is positively oriented
+	if (orientations[0] == 1)
+		return elements[0]->getStart();
+	return elements[0]->getEnd();
+}
+
+const Node& LoopView::lastFree() const
+{
+	// end if last is positively oriented
+	if (orientations[size-1] == 1)
+		return elements[size-1]->getEnd();
+	return elements[size-1]->getStart();
+}
+
+//	Computation ===========================================================
+double LoopView::computeHeadLoss(const Fluid& fluid) const
+	// same as Loop::computeHeadLoss()
+{
+	double headLoss {0};
+	double q {0};
+		// flow rate
 
-static const int MIN_LOOP= 3;
-	// minimum number of elements to form a loop
-static const int MIN_PSEUDOLOOP = 1;
-	// minimum number of elements to form a pseudoloop
+	for (int i {0}; i < size; i++) {
+		q = elements[i]->getFlow();
+		headLoss += double(orientations[i])
+				  * (elements[i]->computeHeadLossC(fluid)*q*abs(q));
+	}
+
+	return headLoss;
+}
 
 //=============================================================================
 //
@@ -40,20 +80,35 @@ static const int MIN_PSEUDOLOOP = 1;
 
 //	Constructors ==========================================================
 LoopDepot::LoopDepot(const Network& net)
-	:mode{0}, lNum{0}, pNum{0}
+	:mode{0}, lNum{0}, pNum{0}, depot{NULL}, offsets{}, elements{},
+	orientations{}, closed(net.getElementQty(), false), basis{}, pivots{}
 {
-	// determine number of loops
-	//  noLoops = noElements + 1 - noNodes
-	lNum = net.getElementQty()+1-net.getNodeQty();
-	// determine number of pseudoloops
-	//  noPseudo = noPressureNodes - 1
-	countPseudo(net);
+	// find loops in Network
+	this->rebuild(net);
+}
 
-	// allocate memory and initialize loops
+LoopDepot::LoopDepot(const LoopDepot& source, const Network& net)
+	:mode{source.mode}, lNum{source.lNum}, pNum{source.pNum}, depot{NULL},
+	offsets{}, elements{}, orientations{}, closed{source.closed}, basis{},
+	pivots{}
+{
+	// allocate memory
 	depot = new Loop[lNum+pNum]{};
 
-	// find loops in Network
-	this->build(net);
+	// copy loops and rebind elements
+	Loop* l;
+	for (int i {0}; i < lNum+pNum; i++) {
+		// assign
+		l = &source.depot[i];
+
+		depot[i].setSize(l->getSize());
+		for (int j {1}; j <= l->getSize(); j++) {
+			depot[i].store(net.getElement(l->getElement(j)->getId()),
+						   l->getOrientation(j));
+		}
+	}
+
+	this->flatten();
 }
 
 LoopDepot::~LoopDepot()
@@ -73,7 +128,7 @@ int LoopDepot::getPNum() const
 {
 	return pNum;
 }
-const Loop LoopDepot::getLoop(const int& i) const
+const Loop& LoopDepot::getLoop(const int& i) const
 
 	// i = id
 {
@@ -83,6 +138,161 @@ const Loop LoopDepot::getLoop(const int& i) const
 	return depot[i-1];
 }
 
+LoopView LoopDepot::getView(const int& i) const
+	// i = id
+{
+	// check bounds
+	checkBounds(i, "getView()");
+
+	return LoopView {&elements[offsets[i-1]], &orientations[offsets[i-1]],
+					 offsets[i] - offsets[i-1]};
+}
+
+bool LoopDepot::isClosed(const int& i) const
+	// i = element id
+{
+	if (i < 1 || i > int(closed.size()))
+		throw runtime_error("LoopDepot::isClosed(): id");
+
+	return closed[i-1];
+}
+
+//	Mutators ==============================================================
+void LoopDepot::close(const Network& net, const int& id)
+	// eliminate element from loops containing it
+{
+	if (this->isClosed(id))
+		throw runtime_error("LoopDepot::close(): closed");
+
+	Profile::Timer timer {Profile::LOOPS};
+	closed[id-1] = true;
+
+	// loops containing element, loops come
+	//  before pseudoloops and are tried as
+	//  pivots first
+	vector<int> affected {};
+
+	for (int i {0}; i < lNum+pNum; i++) {
+		if (this->orientation(i, id) != 0)
+			affected.push_back(i);
+	}
+
+	// a bridge to a part without fixed heads,
+	//  its flows are fixed by continuity
+	if (affected.empty())
+		return;
+
+	vector<Loop> replaced (affected.size());
+	bool viable {false};
+
+	for (int pivot : affected) {
+		// combine all others with pivot
+		viable = true;
+		for (unsigned k {0}; k < affected.size() && viable; k++) {
+			if (affected[k] != pivot)
+				viable = this->combine(net, id, affected[k], pivot, replaced[k]);
+		}
+		if (!viable)
+			continue;
+
+		// replace and drop pivot
+		for (unsigned k {0}; k < affected.size(); k++) {
+			if (affected[k] != pivot)
+				depot[affected[k]] = replaced[k];
+		}
+		this->erase(pivot);
+		this->flatten();
+		return;
+	}
+
+	// no pivot keeps loops simple
+	this->rebuild(net);
+}
+
+void LoopDepot::open(const Network& net, const int& id)
+	// add loop or pseudoloop closed by element
+{
+	if (!this->isClosed(id))
+		throw runtime_error("LoopDepot::open(): open");
+
+	Profile::Timer timer {Profile::LOOPS};
+	Element* e {net.getElement(id)};
+	int start {e->getStart().getId()};
+	int end {e->getEnd().getId()};
+	int reached {0};
+		// target node reached by route
+	vector<bool> target (net.getNodeQty(), false);
+
+	// route back to start, element is still closed
+	target[start-1] = true;
+	vector<pair<Element*, int>> back {this->route(net, end, target, reached)};
+
+	if (reached != 0) {
+		Loop l {int(back.size())+1};
+
+		l.store(e, 1);
+		for (pair<Element*, int>& s : back)
+			l.store(s.first, s.second);
+
+		closed[id-1] = false;
+		this->insert(l, false);
+		this->flatten();
+		return;
+	}
+
+	// a bridge, fixed heads on both sides
+	//  are joined by a pseudoloop
+	for (int i {0}; i < net.getNodeQty(); i++)
+		target[i] = net.getNode(i+1)->isFixed();
+
+	int first {0};
+	int last {0};
+	vector<pair<Element*, int>> up {this->route(net, start, target, first)};
+	vector<pair<Element*, int>> down {this->route(net, end, target, last)};
+
+	closed[id-1] = false;
+	if (first == 0 || last == 0)
+		return;
+
+	Loop l {int(up.size()+down.size())+1};
+
+	// from fixed head to start, reversed route
+	for (int i {int(up.size())-1}; i >= 0; i--)
+		l.store(up[i].first, -up[i].second);
+	l.store(e, 1);
+	for (pair<Element*, int>& s : down)
+		l.store(s.first, s.second);
+
+	this->insert(l, true);
+	this->flatten();
+}
+
+void LoopDepot::rebuild(const Network& net)
+	// search loops of open elements
+{
+	Profile::Timer timer {Profile::LOOPS};
+
+	// determine number of loops
+	//  noLoops = noElements + noParts - noNodes
+	// determine number of pseudoloops
+	//  noPseudo = noPressureNodes - noPressureParts
+	vector<int> parts {this->components(net)};
+	this->countLoops(net, parts);
+	this->countPseudo(net, parts);
+
+	// allocate memory and initialize loops
+	delete[] depot;
+	depot = new Loop[lNum+pNum]{};
+
+	// find loops in Network
+	mode = 0;
+	this->build(net);
+	this->flatten();
+
+	basis.clear();
+	pivots.clear();
+}
+
 //	Computation ===========================================================
 double LoopDepot::contribute(const Fluid& fluid, const int& id) const
 	// get diagonal term in
@@ -94,7 +304,7 @@ double LoopDepot::contribute(const Fluid& fluid, const int& id) const
 		// flow rate
 	double r {0};
 		// head loss coefficient
-	Loop l {this->getLoop(id)};
+	LoopView l {this->getView(id)};
 
 	for (int i {1}; i <= l.getSize(); i++) {
 		// assign
@@ -119,8 +329,8 @@ double LoopDepot::contribute(const Fluid& fluid, const int& first,
 		// sign of contribution
 	double r {0};
 		// head loss coefficient
-	Loop l_1 {this->getLoop(first)};
-	Loop l_2 {this->getLoop(second)};
+	LoopView l_1 {this->getView(first)};
+	LoopView l_2 {this->getView(second)};
 	Element* e_1;
 	Element* e_2;
 
@@ -134,7 +344,7 @@ double LoopDepot::contribute(const Fluid& fluid, const int& first,
 			e_2 = l_2.getElement(j);
 
 			// check if contained
-			if (*e_1 != *e_2)
+			if (e_1 != e_2)
 				continue;
 			
 			// assign
@@ -156,6 +366,88 @@ double LoopDepot::contribute(const Fluid& fluid, const int& first,
 	
 }
 
+//	Validation ============================================================
+void LoopDepot::verify(const Network& net) const
+	// compare with a rebuild
+{
+	LoopDepot reference {*this, net};
+	reference.rebuild(net);
+
+	if (reference.lNum != lNum || reference.pNum != pNum)
+		throw runtime_error("LoopDepot::verify(): count");
+
+	// loops must be circuits of open elements, pseudoloops
+	//  paths between fixed heads, each element once
+	int size {lNum+pNum};
+	int eNum {net.getElementQty()};
+	int nNum {net.getNodeQty()};
+	vector<int> balance (nNum);
+		// outflow minus inflow of node along loop
+	vector<int> seen (eNum, -1);
+		// last loop containing element
+	Element* e;
+	int from;
+	int to;
+
+	for (int i {0}; i < size; i++) {
+		fill(balance.begin(), balance.end(), 0);
+
+		for (int j {offsets[i]}; j < offsets[i+1]; j++) {
+			e = elements[j];
+
+			if (closed[e->getId()-1] || seen[e->getId()-1] == i)
+				throw runtime_error("LoopDepot::verify(): element");
+			seen[e->getId()-1] = i;
+
+			from = e->getStart().getId();
+			to = e->getEnd().getId();
+			if (orientations[j] < 0)
+				swap(from, to);
+
+			balance[from-1]++;
+			balance[to-1]--;
+		}
+
+		// pseudoloop ends
+		if (i >= lNum) {
+			LoopView l {this->getView(i+1)};
+
+			if (!l.firstFree().isFixed() || !l.lastFree().isFixed())
+				throw runtime_error("LoopDepot::verify(): pseudoloop");
+			balance[l.firstFree().getId()-1]--;
+			balance[l.lastFree().getId()-1]++;
+		}
+
+		for (int b : balance) {
+			if (b != 0)
+				throw runtime_error("LoopDepot::verify(): not closed");
+		}
+	}
+
+	// same span, pseudoloops close over a ground
+	//  node joined to every fixed head
+	Eigen::MatrixXd A {Eigen::MatrixXd::Zero(2*size, eNum+nNum)};
+
+	for (int k {0}; k < 2; k++) {
+		const LoopDepot& d {k == 0 ? *this : reference};
+
+		for (int i {0}; i < size; i++) {
+			for (int j {d.offsets[i]}; j < d.offsets[i+1]; j++)
+				A(i+k*size, d.elements[j]->getId()-1) = d.orientations[j];
+
+			if (i >= lNum) {
+				LoopView l {d.getView(i+1)};
+				A(i+k*size, eNum+l.firstFree().getId()-1) -= 1;
+				A(i+k*size, eNum+l.lastFree().getId()-1) += 1;
+			}
+		}
+	}
+
+	if (Eigen::FullPivLU<Eigen::MatrixXd> (A.topRows(size)).rank() != size
+	 || Eigen::FullPivLU<Eigen::MatrixXd> (A).rank() != size)
+		throw runtime_error("LoopDepot::verify(): span");
+}
+
 //	Utility ===============================================================
 ostream& LoopDepot::log(ostream& os) const
 	// log output
@@ -191,53 +483,204 @@ ostream& LoopDepot::log(ostream& os) const
 void LoopDepot::build(const Network& net)
 	// build loop depot
 {
-	// find and store loops
-	// search from smallest to biggest loops
-	const int* minSize {};
-	if (mode == 0)
-		minSize = &MIN_LOOP;
-	else
-		minSize = &MIN_PSEUDOLOOP;
-
-	// initialize pool of
-	//  search starting points
-	Loop pool {};
-
-	for (int i {*minSize}; i <= net.getElementQty(); i++) {
-		// generate pool of search starting points (nonsequential)
-		this->makePool(net, pool);
-
-		// generate buffer (sequential)
-		Loop buffer {i};
-
-		while (!pool.isEmpty()) {
-			// reset buffer
-			buffer.purge();
-
-			// start a new search instance
-			this->search(net, buffer, pool);
-
-			// change search mode if
-			//  all loops were found
-			//  and pseudoloops exist
-			if (mode == 0
-			 && pNum != 0
-			 && lNum == this->stored()) {
-				mode = 1;
-				this->build(net);
-			}
+	// loops from shortest circuits
+	if (mode == 0) {
+		this->cycles(net);
+		mode = 1;
+	}
 
-			// check if all loops were found
-			if (this->isFull())
-				return;
+	// pseudoloops from first fixed head of each
+	//  part, its master, to each other fixed head
+	vector<int> parts {this->components(net)};
+	vector<int> master (net.getNodeQty(), 0);
+		// master of each part, 0 if none
+	vector<bool> target (net.getNodeQty(), false);
+	vector<Loop> paths {};
+	int reached;
+
+	for (int i {1}; i <= net.getNodeQty(); i++) {
+		if (!net.getNode(i)->isFixed())
+			continue;
+
+		if (master[parts[i-1]-1] == 0) {
+			master[parts[i-1]-1] = i;
+			continue;
 		}
+
+		target[i-1] = true;
+		vector<pair<Element*, int>> path {this->route(net,
+				master[parts[i-1]-1], target, reached)};
+		target[i-1] = false;
+
+		Loop l {int(path.size())};
+		for (pair<Element*, int>& s : path)
+			l.store(s.first, s.second);
+		paths.push_back(l);
 	}
 
-	// if no loop network
-	if (mode == 0) {
-		mode = 1;
-		this->build(net);
+	// shortest first, ties by fixed head id
+	stable_sort(paths.begin(), paths.end(),
+		[](const Loop& a, const Loop& b) { return a.getSize() < b.getSize(); });
+
+	for (Loop& l : paths)
+		this->store(l);
+}
+
+void LoopDepot::cycles(const Network& net)
+	// circuits closed by an element over the breadth
+	//  first tree of a node, grown one length at a
+	//  time and stored while independent of those
+	//  stored
+{
+	int nNum {net.getNodeQty()};
+	vector<int> via (nNum, 0);
+		// element id used to reach node,
+		//  signed by orientation
+	vector<int> depth (nNum, -1);
+		// distance from root, -1 if not reached
+	vector<int> branch (nNum, 0);
+		// node below root on path to node
+	vector<int> queue {};
+	vector<int> ids {};
+	Loop* links;
+	Element* e;
+	int next;
+
+	// breadth first tree over node links, nodes
+	//  beyond radius aren't reached
+	auto tree = [&](const int& root, const int& radius) {
+		for (int n : queue)
+			depth[n-1] = -1;
+		depth[root-1] = 0;
+		via[root-1] = 0;
+		branch[root-1] = root;
+		queue.assign(1, root);
+
+		for (unsigned i {0}; i < queue.size(); i++) {
+			if (depth[queue[i]-1] == radius)
+				break;
+
+			links = net.getNode(queue[i])->links;
+			for (int k {1}; k <= links->getSize(); k++) {
+				e = links->getElement(k);
+				if (closed[e->getId()-1])
+					continue;
+
+				// node is start of positively linked
+				next = e->getEnd().getId();
+				if (links->getOrientation(k) < 0)
+					next = e->getStart().getId();
+
+				if (depth[next-1] < 0) {
+					depth[next-1] = depth[queue[i]-1]+1;
+					via[next-1] = links->getOrientation(k) * e->getId();
+					branch[next-1] = queue[i] == root ? next
+									 : branch[queue[i]-1];
+					queue.push_back(next);
+				}
+			}
+		}
+	};
+
+	// parent of node in tree
+	auto parent = [&](const int& n) {
+		e = net.getElement(abs(via[n-1]));
+		return via[n-1] > 0 ? e->getStart().getId() : e->getEnd().getId();
+	};
+
+	// a circuit of given length lies within radius
+	//  length/2 of root, circuits whose tree paths
+	//  meet only at root hold a shortest basis,
+	//  and are found from a root on the circuit
+	int start;
+	int end;
+	int id;
+
+	for (int length {1}; length <= 2*nNum && this->stored() < lNum;
+		 length++) {
+		for (int root {1}; root <= nNum && this->stored() < lNum; root++) {
+			tree(root, length/2);
+
+			// elements closing circuits of length, each
+			//  seen from both ends
+			ids.clear();
+			for (int n : queue) {
+				links = net.getNode(n)->links;
+
+				for (int k {1}; k <= links->getSize(); k++) {
+					id = links->getElement(k)->getId();
+					start = links->getElement(k)->getStart().getId();
+					end = links->getElement(k)->getEnd().getId();
+
+					// skip closed, unreached and tree elements
+					if (closed[id-1] || depth[start-1] < 0
+					 || depth[end-1] < 0
+					 || abs(via[start-1]) == id || abs(via[end-1]) == id)
+						continue;
+
+					if (depth[start-1] + depth[end-1] + 1 == length
+					 && (start == root || end == root
+					  || branch[start-1] != branch[end-1]))
+						ids.push_back(id);
+				}
+			}
+
+			// ties by element id
+			sort(ids.begin(), ids.end());
+			ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+			for (int c : ids) {
+				if (this->stored() == lNum)
+					break;
+
+				start = net.getElement(c)->getStart().getId();
+				end = net.getElement(c)->getEnd().getId();
+
+				// element from start to end, up to root
+				//  and down back to start
+				vector<pair<int, int>> circuit {{c, 1}};
+				vector<pair<int, int>> down {};
+
+				for (int n {end}; n != root; n = parent(n))
+					circuit.push_back({abs(via[n-1]), via[n-1] > 0 ? -1 : 1});
+				for (int n {start}; n != root; n = parent(n))
+					down.push_back({abs(via[n-1]), via[n-1] > 0 ? 1 : -1});
+				circuit.insert(circuit.end(), down.rbegin(), down.rend());
+
+				// lowest element id first and
+				//  positively oriented
+				if (min_element(circuit.begin(), circuit.end())->second < 0) {
+					reverse(circuit.begin(), circuit.end());
+					for (pair<int, int>& s : circuit)
+						s.second = -s.second;
+				}
+				rotate(circuit.begin(),
+					   min_element(circuit.begin(), circuit.end()),
+					   circuit.end());
+
+				Loop l {length};
+				for (pair<int, int>& s : circuit)
+					l.store(net.getElement(s.first), s.second);
+
+				if (!this->isLoop(l))
+					continue;
+
+				// store and add to reduced loops
+				this->store(l);
+				basis.push_back(this->reduce(l));
+				for (unsigned i {0}; i < basis.back().size(); i++) {
+					if (basis.back()[i] != 0) {
+						pivots.push_back(64*i
+							+ __builtin_ctzll(basis.back()[i]));
+						break;
+					}
+				}
+			}
+		}
 	}
+
+	if (this->stored() != lNum)
+		throw runtime_error("LoopDepot::cycles(): loops");
 }
 
 void LoopDepot::store(const Loop& l)
@@ -256,128 +699,278 @@ void LoopDepot::store(const Loop& l)
 	}
 }
 
-//	Processing ============================================================
-void LoopDepot::search(const Network& net, Loop& buffer, Loop& pool)
-	// find loops from a Network object
+void LoopDepot::flatten()
+	// flat storage, loops in depot order
 {
-	// process empty buffer
-	if (buffer.isEmpty()) {
-		this->processEmpty(buffer, pool);
+	int size {0};
+	for (int i {0}; i < lNum+pNum; i++)
+		size += depot[i].getSize();
+
+	// a single allocation per array
+	offsets.clear();
+	elements.clear();
+	orientations.clear();
+	offsets.reserve(lNum+pNum+1);
+	elements.reserve(size);
+	orientations.reserve(size);
+
+	offsets.push_back(0);
+	for (int i {0}; i < lNum+pNum; i++) {
+		for (int j {1}; j <= depot[i].getSize(); j++) {
+			elements.push_back(depot[i].getElement(j));
+			orientations.push_back(depot[i].getOrientation(j));
+		}
+		offsets.push_back(elements.size());
 	}
+}
 
-	// process full buffer
-	if (buffer.isFull()) {
-		this->processFull(buffer, pool);
-		return;
+void LoopDepot::insert(const Loop& l, const bool& pseudo)
+	// append to loops or pseudoloops
+{
+	Loop* list {new Loop[lNum+pNum+1]{}};
+	int at {pseudo ? lNum+pNum : lNum};
+
+	for (int i {0}, j {0}; i < lNum+pNum+1; i++) {
+		if (i == at)
+			list[i] = l;
+		else
+			list[i] = depot[j++];
 	}
 
-	// work with buffer
-	for (int i {1}; i <= net.getElementQty(); i++) {
-		// process active buffer
-		if (this->processActive(net.getElement(i), buffer))
-			this->search(net, buffer, pool);
+	delete[] depot;
+	depot = list;
 
-		// check if all loops have beed found
-		if (mode == 0 && lNum == this->stored())
-			return;
-		if (this->isFull())
-			return;
+	if (pseudo)
+		pNum++;
+	else
+		lNum++;
+}
+
+void LoopDepot::erase(const int& at)
+	// remove a loop or pseudoloop
+{
+	Loop* list {new Loop[lNum+pNum-1]{}};
+
+	for (int i {0}, j {0}; i < lNum+pNum; i++) {
+		if (i != at)
+			list[j++] = depot[i];
 	}
 
-	// process inactive buffer
-	this->processInactive(buffer, pool);
+	delete[] depot;
+	depot = list;
+
+	if (at < lNum)
+		lNum--;
+	else
+		pNum--;
 }
 
-void LoopDepot::processFull(Loop& buffer, Loop& pool)
-	// process a full buffer
+//	Updates ===============================================================
+int LoopDepot::orientation(const int& i, const int& id) const
 {
-	// process loop
-	if (mode == 0 && this->isLoop(buffer)) {
-		// store
-		this->store(buffer);
-		// remove loop elements from pool
-		for (int i {1}; i <= buffer.getSize(); i++) {
-			pool.remove(buffer.getElement(i)->getId());
-		}
-	}
-	// process pseudo loop
-	else if (mode == 1 && this->isPseudo(buffer)) {
-		// store
-		this->store(buffer);
+	for (int j {offsets[i]}; j < offsets[i+1]; j++) {
+		if (elements[j]->getId() == id)
+			return orientations[j];
 	}
-
-	// remove last stored
-	buffer.remove();
+	return 0;
 }
 
-void LoopDepot::processEmpty(Loop& buffer, Loop& pool)
-	// process an empty buffer
+bool LoopDepot::combine(const Network& net, const int& id, const int& i,
+				const int& pivot, Loop& result) const
+	// result = loop - sign * pivot
 {
-	// determine starting element
-	Element* start {pool.getFirstAvailable()};
-	int orient {pool.getOrientation(start->getId())};
+	// a loop can't absorb a pseudoloop
+	if (i < lNum && pivot >= lNum)
+		return false;
 
-	// set
-	buffer.store(start, orient);
+	map<int, int> sum {};
+		// element id and orientation
+	int sign {this->orientation(i, id) * this->orientation(pivot, id)};
 
-	// remove from pool
-	pool.remove(start->getId());
+	for (int j {offsets[i]}; j < offsets[i+1]; j++)
+		sum[elements[j]->getId()] += orientations[j];
+	for (int j {offsets[pivot]}; j < offsets[pivot+1]; j++)
+		sum[elements[j]->getId()] -= sign * orientations[j];
+
+	// drop cancelled, element can't be traversed twice
+	for (auto s = sum.begin(); s != sum.end();) {
+		if (abs(s->second) > 1)
+			return false;
+
+		if (s->second == 0)
+			s = sum.erase(s);
+		else
+			s++;
+	}
+
+	return this->chain(net, sum, i >= lNum, result);
 }
 
-bool LoopDepot::processActive(Element*& current, Loop& buffer)
-	// process an active buffer
+bool LoopDepot::chain(const Network& net, const map<int, int>& sum,
+				const bool& pseudo, Loop& result) const
+	// Hierholzer trails, a pseudoloop path from
+	//  first to last free node is split after its
+	//  first element to hold remaining circuits
 {
-	// assume buffer will become inactive
-	bool active {false};
+	map<int, vector<pair<int, int>>> out {};
+		// node id, outgoing elements with orientation
+	map<int, int> balance {};
+		// node id, outflow minus inflow
+	int from;
+	int to;
+
+	for (const pair<const int, int>& s : sum) {
+		from = net.getElement(s.first)->getStart().getId();
+		to = net.getElement(s.first)->getEnd().getId();
+		if (s.second < 0)
+			swap(from, to);
+
+		out[from].push_back(s);
+		balance[from]++;
+		balance[to]--;
+	}
+
+	// ends of path
+	int first {0};
+	int last {0};
+	int ends {0};
+
+	for (pair<const int, int>& b : balance) {
+		if (b.second == 1)
+			first = b.first;
+		else if (b.second == -1)
+			last = b.first;
+		else if (b.second != 0)
+			return false;
 
-	// check if current is already in buffer
-	for (int i {1}; i <= buffer.getTerminus(); i++) {
-		if (*buffer.getElement(i) == *current)
-			return active;
+		ends += abs(b.second);
 	}
 
-	// attempt to link
-	active = this->link(current, buffer);
+	if (ends != (pseudo ? 2 : 0) || sum.empty())
+		return false;
+	if (pseudo && (!net.getNode(first)->isFixed()
+				|| !net.getNode(last)->isFixed()))
+		return false;
 
-	// return buffer state
-	return active;
-}
+	// lowest element id is taken first
+	for (pair<const int, vector<pair<int, int>>>& o : out)
+		reverse(o.second.begin(), o.second.end());
 
-void LoopDepot::processInactive(Loop& buffer, Loop& pool)
-{
-	// check for 1 element pseudoloops
-	if (buffer.isEmpty())
-		return;
+	// trail from node, consumes elements
+	auto trail = [&](const int& start) {
+		vector<pair<int, int>> circuit {};
+		vector<pair<int, pair<int, int>>> stack {{start, {0, 0}}};
 
-	// store id of previous
-	int lastId {buffer.getElement(buffer.getTerminus())->getId()};
-	// remove last stored
-	buffer.remove();
-	
-	// if search starting point was removed
-	if (buffer.isEmpty())
-		// remove from pool
-		pool.remove(lastId);
+		while (!stack.empty()) {
+			vector<pair<int, int>>& o {out[stack.back().first]};
+
+			if (!o.empty()) {
+				pair<int, int> s {o.back()};
+				o.pop_back();
+
+				to = net.getElement(s.first)->getEnd().getId();
+				if (s.second < 0)
+					to = net.getElement(s.first)->getStart().getId();
+
+				stack.push_back({to, s});
+			}
+			else {
+				if (stack.back().second.first != 0)
+					circuit.push_back(stack.back().second);
+				stack.pop_back();
+			}
+		}
+
+		reverse(circuit.begin(), circuit.end());
+		return circuit;
+	};
+
+	vector<pair<int, int>> path {};
+	vector<pair<int, int>> circuits {};
+
+	if (pseudo)
+		path = trail(first);
+
+	for (pair<const int, vector<pair<int, int>>>& o : out) {
+		while (!o.second.empty()) {
+			vector<pair<int, int>> c {trail(o.first)};
+			circuits.insert(circuits.end(), c.begin(), c.end());
+		}
+	}
+
+	// circuits can't be held by a single element path
+	if (pseudo && path.size() < 2 && !circuits.empty())
+		return false;
+
+	if (pseudo)
+		circuits.insert(circuits.begin(), path.begin(), path.begin()+1);
+	if (pseudo)
+		circuits.insert(circuits.end(), path.begin()+1, path.end());
+
+	result.setSize(circuits.size());
+	for (pair<int, int>& s : circuits)
+		result.store(net.getElement(s.first), s.second);
+
+	return true;
 }
 
-//	Checks ================================================================
-bool LoopDepot::link(Element*& current, Loop& buffer) const
-	// attempt to link previous and current
+vector<pair<Element*, int>> LoopDepot::route(const Network& net,
+				const int& from, const vector<bool>& target,
+				int& reached) const
+	// breadth first over node links
 {
-	// compare free node of previous and start of current
-	if (buffer.lastFree() == current->getStart()) {
-		buffer.store(current, 1);
-		return true;
+	vector<int> via (net.getNodeQty(), 0);
+		// element id used to reach node,
+		//  signed by orientation
+	vector<bool> visited (net.getNodeQty(), false);
+	vector<int> queue {from};
+	Loop* links;
+	Element* e;
+	int next;
+
+	reached = 0;
+	visited[from-1] = true;
+
+	for (unsigned i {0}; i < queue.size() && reached == 0; i++) {
+		if (target[queue[i]-1]) {
+			reached = queue[i];
+			break;
+		}
+
+		links = net.getNode(queue[i])->links;
+		for (int k {1}; k <= links->getSize(); k++) {
+			e = links->getElement(k);
+			if (closed[e->getId()-1])
+				continue;
+
+			// node is start of positively linked
+			next = e->getEnd().getId();
+			if (links->getOrientation(k) < 0)
+				next = e->getStart().getId();
+
+			if (!visited[next-1]) {
+				visited[next-1] = true;
+				via[next-1] = links->getOrientation(k) * e->getId();
+				queue.push_back(next);
+			}
+		}
 	}
-	// compare free node of previous and end of current	
-	else if (buffer.lastFree() == current->getEnd()) {
-		buffer.store(current, -1);
-		return true;
+
+	// walk back from reached
+	vector<pair<Element*, int>> path {};
+
+	for (int n {reached}; n != 0 && n != from;) {
+		e = net.getElement(abs(via[n-1]));
+		path.push_back({e, via[n-1] > 0 ? 1 : -1});
+
+		n = via[n-1] > 0 ? e->getStart().getId() : e->getEnd().getId();
 	}
+	reverse(path.begin(), path.end());
 
-	return false;
+	return path;
 }
 
+//	Checks ================================================================
 bool LoopDepot::isFull() const
 	// check if depot is full
 {
@@ -412,88 +1005,118 @@ bool LoopDepot::isLoop(const Loop& l) const
 		return false;
 
 	// check if is unique
-	return this->isUnique(l);
+	if (!this->isUnique(l))
+		return false;
+
+	// check if independent, a loop may be the
+	//  sum of smaller ones found before
+	vector<unsigned long long> r {this->reduce(l)};
+	for (unsigned long long w : r) {
+		if (w != 0)
+			return true;
+	}
+	return false;
 }
 
-bool LoopDepot::isPseudo(Loop& l) const
+vector<unsigned long long> LoopDepot::reduce(const Loop& l) const
+	// Gaussian elimination modulo 2
 {
-	// check if is full
-	if (!l.isFull())
-		return false;
-	
-	// check if ending node is a pressure node
-	if (l.lastFree().getPressure() == 0)
-		return false;
-	
-	// check if ending node is different from master
-	if (l.lastFree().getId() == l.firstFree().getId())
-		return false;
+	vector<unsigned long long> r ((closed.size()+63)/64, 0);
+	int id;
 
-	// check if ending node is different than
-	//  ending nodes of previous pseudoloops
-	for (int i {lNum}; i < this->stored(); i++) {
-		if (l.lastFree().getId() == depot[i].lastFree().getId())
-			return false;
+	for (int i {1}; i <= l.getSize(); i++) {
+		id = l.getElement(i)->getId()-1;
+		r[id/64] ^= 1ULL << (id%64);
 	}
 
-	return true;
+	// stored loops hold no earlier pivots
+	for (unsigned k {0}; k < basis.size(); k++) {
+		if (!(r[pivots[k]/64] >> (pivots[k]%64) & 1))
+			continue;
+
+		for (unsigned i {0}; i < r.size(); i++)
+			r[i] ^= basis[k][i];
+	}
+
+	return r;
 }
 
 //	Validation ============================================================
-void LoopDepot::checkBounds(const int& i, const string& s) const
+void LoopDepot::checkBounds(const int& i, const char* s) const
 {
 	if (i > lNum+pNum || i < 1)
-		throw runtime_error("LoopDepot::checkBounds(): "+s);
+		throw runtime_error(string("LoopDepot::checkBounds(): ")+s);
 }
 
 //	Utility ===============================================================
-void LoopDepot::makePool(const Network& net, Loop& pool)
-	// generate pool of search starting points
+vector<int> LoopDepot::components(const Network& net) const
+	// union find over open elements
 {
-	pool.setSize(net.getElementQty());
-
-	// set pool for loop mode
-	if (mode == 0) {
-		// fill with elements
-		for (int i {1}; i <= net.getElementQty(); i++) {
-			pool.store(net.getElement(i), 1);
+	vector<int> parent (net.getNodeQty());
+	for (int i {0}; i < net.getNodeQty(); i++)
+		parent[i] = i;
+
+	// root with path halving
+	auto find = [&parent](int n) {
+		while (parent[n] != n) {
+			parent[n] = parent[parent[n]];
+			n = parent[n];
 		}
-		return;
+		return n;
+	};
+
+	int a;
+	int b;
+	for (int i {1}; i <= net.getElementQty(); i++) {
+		if (closed[i-1])
+			continue;
+
+		a = find(net.getElement(i)->getStart().getId()-1);
+		b = find(net.getElement(i)->getEnd().getId()-1);
+
+		// lowest id is root
+		if (a < b)
+			parent[b] = a;
+		else
+			parent[a] = b;
 	}
 
-	// set pool for pseudoloop mode
-	// set master
-	int master {};
-	for (int i {1}; i <= net.getNodeQty(); i++) {
-		if (net.getNode(i)->getPressure() != 0
-		|| net.getNode(i)->getHead() != 0) {
-			master = net.getNode(i)->getId();
-			break;
-		}
+	vector<int> parts (net.getNodeQty());
+	for (int i {0}; i < net.getNodeQty(); i++)
+		parts[i] = find(i)+1;
+
+	return parts;
+}
+
+void LoopDepot::countLoops(const Network& net, const vector<int>& parts)
+	// set number of loops
+{
+	lNum = -net.getNodeQty();
+
+	for (int i {0}; i < net.getElementQty(); i++) {
+		if (!closed[i])
+			lNum++;
 	}
-	// only search from elements containing master
-	// master will always be starting node of loop
-	for (int i {1}; i <= net.getElementQty(); i++) {
-		// if master is start
-		if (net.getElement(i)->getStart().getId() == master) {
-			pool.store(net.getElement(i), 1, i);
-		}
-		// if master is end
-		else if (net.getElement(i)->getEnd().getId() == master) {
-			pool.store(net.getElement(i), -1, i);
-		}
+	for (int i {0}; i < net.getNodeQty(); i++) {
+		if (parts[i] == i+1)
+			lNum++;
 	}
 }
 
-void LoopDepot::countPseudo(const Network& net)
+void LoopDepot::countPseudo(const Network& net, const vector<int>& parts)
 	// set number of pseudoloops
 {
-	pNum = -1;
+	pNum = 0;
+	vector<bool> found (net.getNodeQty(), false);
 
 	for (int i {1}; i <= net.getNodeQty(); i++) {
-		if (net.getNode(i)->getPressure() != 0
-		 || net.getNode(i)->getHead() != 0)
+		if (!net.getNode(i)->isFixed())
+			continue;
+
+		// first fixed head of a part is its master
+		if (found[parts[i-1]-1])
 			pNum++;
+		found[parts[i-1]-1] = true;
 	}
 }
 
@@ -3,7 +3,7 @@
 // created:	8-9-2018
 // version:	0.2
 //
-// last edit:	13-9-2018
+// last edit:	18-10-2026
 //
 //
 // definitions in: LoopDepot.cpp
@@ -16,21 +16,81 @@
 
 #include<ostream>
 #include<string>
+#include<vector>
+#include<map>
+#include<utility>
 
 #include"Loop.h"
 #include"Network.h"
 #include"Fluid.h"
 
+//=============================================================================
+//
+//	LoopView
+
+// view of a loop stored in a LoopDepot
+// - doesn't own or copy the loop
+// - valid as long as the depot exists
+// - indexing starts from 1, as in Loop, and
+//   is not bounds checked
+class LoopView {
+public:
+	// constructors
+	LoopView(Element* const*, const int*, const int&);
+
+	// accessors
+	int getSize() const;
+		// get size of loop
+	Element* getElement(const int&) const;
+		// get element of loop
+	int getOrientation(const int&) const;
+		// get orientation of element in loop
+	const Node& firstFree() const;
+		// get starting node of loop
+		//  based on orientation
+	const Node& lastFree() const;
+		// get ending node of loop
+		//  based on orientation
+
+	// computation
+	double computeHeadLoss(const Fluid&) const;
+		// compute sum head loss
+
+private:
+	Element* const* elements;
+		// first element of loop
+	const int* orientations;
+		// first orientation of loop
+	int size;
+		// number of elements
+};
+
 //=============================================================================
 //
 //	LoopDepot
 
 // generates and stores loops from a Network object
 // - indexing starts at 1 (getLoop(1) to get first loop))
+/* elements can be closed and reopened without a new search
+ * - closing removes the element from the loops containing it
+ *   by adding one of them, the pivot, to the others and
+ *   dropping the pivot, a rebuild is the fallback when no
+ *   pivot leaves each element once in every loop
+ * - opening adds the shortest loop closed by the element,
+ *   or a pseudoloop if it joins two parts with fixed heads
+ * - loops kept this way span the same loops as a rebuild,
+ *   but may differ from those a rebuild would find, and
+ *   a loop may consist of several circuits
+*/
 class LoopDepot {
 public:
 	// constructors
 	LoopDepot(const Network&);
+	LoopDepot(const LoopDepot&, const Network&);
+		// copy loops of a depot built for
+		//  another copy of the same network
+		// elements are rebound by id,
+		//  closed elements stay closed
 	~LoopDepot();
 
 	// accessors
@@ -38,8 +98,24 @@ public:
 		// get number of loops
 	int getPNum() const;
 		// get number of pseudoloops
-	const Loop getLoop(const int&) const;
+	const Loop& getLoop(const int&) const;
 		// get a loop from depot
+		// - a view, loop is not copied
+	LoopView getView(const int&) const;
+		// get a view of a loop in flat storage
+	bool isClosed(const int&) const;
+		// check if element is closed, input is id
+
+	// mutators
+	void close(const Network&, const int&);
+		// close element and update loops containing it
+		// - input is id of element
+	void open(const Network&, const int&);
+		// reopen closed element and add the
+		//  loop or pseudoloop it closes
+		// - input is id of element
+	void rebuild(const Network&);
+		// search all loops of open elements
 	
 	// computation
 	double contribute(const Fluid&, const int&) const;
@@ -53,6 +129,11 @@ public:
 		//  matrix
 		// d(hf_i)/d(deltaQ_j)
 	
+	// validation
+	void verify(const Network&) const;
+		// compare loops with a rebuild, throws if
+		//  they don't span the same loops
+
 	// utility
 	std::ostream& log(std::ostream&) const;
 		// log output
@@ -66,34 +147,62 @@ private:
 		// number of pseudoloops
 	Loop* depot;
 		// an array of loops
+	std::vector<int> offsets;
+		// first index of each loop in flat
+		//  storage, offsets[lNum+pNum] = end
+	std::vector<Element*> elements;
+		// elements of all loops in order
+	std::vector<int> orientations;
+		// orientations of all loops in order
+	std::vector<bool> closed;
+		// closed elements, by id-1
+	std::vector<std::vector<unsigned long long>> basis;
+		// stored loops as sets of elements, reduced
+		//  modulo 2, used while building
+	std::vector<int> pivots;
+		// lowest element id-1 of each reduced loop
 
 	// generation
 	void build(const Network&);
-		// scan network for loops
-		// process loops found
-		// store unique loops only
+		// find loops, then pseudoloops as shortest
+		//  routes from the first fixed head of each
+		//  part to each other fixed head
+	void cycles(const Network&);
+		// store shortest independent loops
+		// - candidates close a breadth first tree
+		//   of each node, grown one circuit length
+		//   at a time
 	void store(const Loop&);
 		// store a loop at first available space
-	
-	// processing
-	void search(const Network&, Loop&, Loop&);
-		// find loops of certain size from a Network object
-		// determine starting element from pool
-		// orient starting element positively
-	void processFull(Loop&, Loop&);
-		// process a full search buffer
-	void processEmpty(Loop&, Loop&);
-		// process an empty search buffer
-	bool processActive(Element*&, Loop&);
-		// process active search buffer
-	void processInactive(Loop&, Loop&);
-		// process an inactive search buffer
+	void flatten();
+		// copy stored loops to flat storage
+	void insert(const Loop&, const bool&);
+		// append a loop, or a pseudoloop if true
+	void erase(const int&);
+		// remove loop, input is id-1
 
+	// updates
+	int orientation(const int&, const int&) const;
+		// orientation of element in loop, 0 if
+		//  not contained, inputs are id-1 and id
+	bool combine(const Network&, const int&, const int&, const int&,
+				Loop&) const;
+		// add pivot to a loop so that element cancels
+		// - inputs are element id, loop and pivot id-1
+		// - false if an element would be traversed
+		//   twice or a loop would become a pseudoloop
+	bool chain(const Network&, const std::map<int, int>&, const bool&,
+				Loop&) const;
+		// order elements with orientations into a loop,
+		//  a pseudoloop path comes first and last
+		// - false if elements can't form the loop type
+	std::vector<std::pair<Element*, int>> route(const Network&, const int&,
+				const std::vector<bool>&, int&) const;
+		// shortest path of open elements from node
+		//  to a target node, breadth first
+		// - reached target is set, 0 if none
+	
 	// checks
-	bool link(Element*&, Loop&) const;
-		// attempt to link new element to
-		//  last stored in buffer
-		// true if success
 	bool isFull() const;
 		// check if all loops have been found
 	bool isUnique(const Loop&) const;
@@ -103,27 +212,44 @@ private:
 		// check if buffer is a loop
 		// - loop must be full to be stored
 		// - loop must be unique to be stored
-	bool isPseudo(Loop&) const;
-		// check if buffer is a pseudoloop
-		// - loop must be full to be stored
-		// - loop must be unique to be stored
-		// - first and last nodes must have pressures assigned
+		// - loop must be independent of those
+		//   stored to be stored
+	std::vector<unsigned long long> reduce(const Loop&) const;
+		// element set of loop reduced by stored
+		//  loops modulo 2, empty set if dependent
 
 	// validation
-	void checkBounds(const int&, const std::string&) const;
+	void checkBounds(const int&, const char*) const;
 		// check if trying to access out of bounds
 
 	// utility
-	void makePool(const Network&, Loop&);
-		// generate pool of search starting points
-		// elements stored in order by their ids
-		// in pseudoloop mode
-		//  master is always starting node of loop
-	void countPseudo(const Network&);
+	std::vector<int> components(const Network&) const;
+		// connected part of each node over open
+		//  elements, named by its lowest node id
+	void countLoops(const Network&, const std::vector<int>&);
+		// set number of loops
+	void countPseudo(const Network&, const std::vector<int>&);
 		// set number of pseudoloops
 	int stored() const;
 		// get number of stored loops
 };
 
+//	Inline ================================================================
+
+inline int LoopView::getSize() const
+{
+	return size;
+}
+
+inline Element* LoopView::getElement(const int& i) const
+{
+	return elements[i-1];
+}
+
+inline int LoopView::getOrientation(const int& i) const
+{
+	return orientations[i-1];
+}
+
 #endif
 
@@ -0,0 +1,373 @@
+// Definitions for Encoder and Decoder classes
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<stdexcept>
+#include<fstream>
+#include<string>
+#include<vector>
+#include<cstring>
+#include<cstdint>
+
+#include"Codec.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Constants
+
+static const char MAGIC[4] {'H', 'N', 'C', '1'};
+	// file signature
+static const int HEADER_SIZE {20};
+	// magic + 4x uint32
+static const int FRAMES_OFFSET {16};
+	// position of frame count in header
+static const unsigned char NO_WINDOW {255};
+	// marks a slot without a stored window
+static const int MAX_LEADING {31};
+	// largest leading zero count in 5 bits
+static const size_t BUFFER_SIZE {1 << 16};
+	// bytes buffered before writing
+
+//=============================================================================
+//
+//	Helper
+
+namespace {
+
+inline uint64_t mask(const int& n)
+	// lowest n bits set
+{
+	return n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+}
+
+}
+
+namespace Codec {
+
+string fieldName(const int& field)
+{
+	switch (field) {
+		case VELOCITY:
+			return "v";
+		case HEAD:
+			return "H";
+		case PRESSURE:
+			return "p";
+		case FRICTION:
+			return "f";
+		case GAS_FRACTION:
+			return "alpha";
+	}
+	throw runtime_error("Codec::fieldName(): invalid field");
+}
+
+//=============================================================================
+//
+//	Encoder
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+Encoder::Encoder()
+	:ofs{}, meshSize{0}, frames{0}, previous{}, leading{}, trailing{},
+	buffer{}, bits{0}, bitCount{0}, rawBytes{0}, bytes{0} {}
+
+Encoder::~Encoder()
+{
+	this->close();
+}
+
+//	Accessors =============================================================
+uint64_t Encoder::getRawBytes() const
+{
+	return rawBytes;
+}
+
+uint64_t Encoder::getBytes() const
+{
+	return bytes;
+}
+
+//	Utility ===============================================================
+void Encoder::open(const string& file, const int& element, const int& field,
+				   const int& size)
+{
+	if (size < 1)
+		throw runtime_error("Codec::Encoder::open(): mesh size");
+
+	ofs.open(file.c_str(), ios_base::binary | ios_base::trunc);
+	if (!ofs)
+		throw runtime_error("Codec::Encoder::open(): "+file);
+
+	// reset state
+	meshSize = size;
+	frames = 0;
+	previous.assign(meshSize+1, 0);
+	leading.assign(meshSize+1, NO_WINDOW);
+	trailing.assign(meshSize+1, 0);
+	buffer.clear();
+	buffer.reserve(BUFFER_SIZE);
+	bits = 0;
+	bitCount = 0;
+	rawBytes = 0;
+
+	// header, frame count is set on close
+	uint32_t header[4] {uint32_t(element), uint32_t(field), meshSize, 0};
+	ofs.write(MAGIC, sizeof(MAGIC));
+	ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+	bytes = HEADER_SIZE;
+}
+
+void Encoder::write(const double& time, const vector<double>& values)
+{
+	if (values.size() != meshSize)
+		throw runtime_error("Codec::Encoder::write(): frame size");
+
+	this->encode(time, 0);
+	for (uint32_t i {0}; i < meshSize; i++) {
+		this->encode(values[i], i+1);
+	}
+
+	frames++;
+	rawBytes += sizeof(double) * (meshSize+1);
+
+	if (buffer.size() >= BUFFER_SIZE)
+		this->flush(false);
+}
+
+void Encoder::close()
+{
+	if (!ofs.is_open())
+		return;
+
+	this->flush(true);
+
+	// store frame count
+	ofs.seekp(FRAMES_OFFSET);
+	ofs.write(reinterpret_cast<const char*>(&frames), sizeof(frames));
+	ofs.close();
+}
+
+//=============================================================================
+//	Private
+
+void Encoder::encode(const double& value, const int& slot)
+{
+	uint64_t v;
+	memcpy(&v, &value, sizeof(v));
+
+	uint64_t x {v ^ previous[slot]};
+	previous[slot] = v;
+
+	// unchanged
+	if (x == 0) {
+		this->put(0, 1);
+		return;
+	}
+
+	int lead {__builtin_clzll(x)};
+	int trail {__builtin_ctzll(x)};
+	if (lead > MAX_LEADING)
+		lead = MAX_LEADING;
+
+	// fits previous window
+	if (leading[slot] != NO_WINDOW
+	 && lead >= leading[slot]
+	 && trail >= trailing[slot]) {
+		this->put(2, 2);
+		this->put(x >> trailing[slot], 64 - leading[slot] - trailing[slot]);
+	}
+	// new window
+	else {
+		int length {64 - lead - trail};
+
+		this->put(3, 2);
+		this->put(lead, 5);
+		this->put(length & 63, 6);
+		this->put(x >> trail, length);
+
+		leading[slot] = lead;
+		trailing[slot] = trail;
+	}
+}
+
+void Encoder::put(const uint64_t& value, const int& n)
+	// MSB first, at most 32 bits are appended at a time
+{
+	uint64_t v {value};
+	int m {n};
+
+	if (m > 32) {
+		this->put(v >> 32, m-32);
+		m = 32;
+	}
+
+	bits = (bits << m) | (v & mask(m));
+	bitCount += m;
+
+	while (bitCount >= 8) {
+		bitCount -= 8;
+		buffer.push_back((bits >> bitCount) & 0xff);
+	}
+	bits &= mask(bitCount);
+}
+
+void Encoder::flush(const bool& final)
+{
+	// pad last byte
+	if (final && bitCount > 0) {
+		buffer.push_back((bits << (8-bitCount)) & 0xff);
+		bits = 0;
+		bitCount = 0;
+	}
+
+	ofs.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	bytes += buffer.size();
+	buffer.clear();
+}
+
+//=============================================================================
+//
+//	Decoder
+
+//=============================================================================
+//	Public
+
+//	Constructors ==========================================================
+Decoder::Decoder(const string& file)
+	:ifs{file.c_str(), ios_base::binary}, element{0}, field{0},
+	meshSize{0}, frames{0}, decoded{0}, previous{}, leading{},
+	trailing{}, bits{0}, bitCount{0}
+{
+	if (!ifs)
+		throw runtime_error("Codec::Decoder(): "+file+" missing");
+
+	char magic[4] {};
+	uint32_t header[4] {};
+
+	ifs.read(magic, sizeof(magic));
+	ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!ifs || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+		throw runtime_error("Codec::Decoder(): "+file+" invalid");
+
+	element = header[0];
+	field = header[1];
+	meshSize = header[2];
+	frames = header[3];
+
+	previous.assign(meshSize+1, 0);
+	leading.assign(meshSize+1, NO_WINDOW);
+	trailing.assign(meshSize+1, 0);
+}
+
+Decoder::~Decoder()
+{}
+
+//	Accessors =============================================================
+int Decoder::getElement() const
+{
+	return element;
+}
+
+int Decoder::getField() const
+{
+	return field;
+}
+
+int Decoder::getMeshSize() const
+{
+	return meshSize;
+}
+
+int Decoder::getFrames() const
+{
+	return frames;
+}
+
+//	Utility ===============================================================
+bool Decoder::read(double& time, vector<double>& values)
+{
+	if (decoded == frames)
+		return false;
+
+	values.resize(meshSize);
+
+	time = this->decode(0);
+	for (uint32_t i {0}; i < meshSize; i++) {
+		values[i] = this->decode(i+1);
+	}
+
+	decoded++;
+	return true;
+}
+
+//=============================================================================
+//	Private
+
+double Decoder::decode(const int& slot)
+{
+	uint64_t x {0};
+
+	// changed
+	if (this->get(1) == 1) {
+		// new window
+		if (this->get(1) == 1) {
+			leading[slot] = this->get(5);
+			int length {int(this->get(6))};
+			if (length == 0)
+				length = 64;
+			trailing[slot] = 64 - leading[slot] - length;
+		}
+		else if (leading[slot] == NO_WINDOW) {
+			throw runtime_error("Codec::Decoder::decode(): corrupt stream");
+		}
+
+		int length {64 - leading[slot] - trailing[slot]};
+		x = this->get(length) << trailing[slot];
+	}
+
+	previous[slot] ^= x;
+
+	double value;
+	memcpy(&value, &previous[slot], sizeof(value));
+
+	return value;
+}
+
+uint64_t Decoder::get(const int& n)
+	// MSB first, at most 32 bits are taken at a time
+{
+	if (n > 32) {
+		uint64_t high {this->get(n-32)};
+		return (high << 32) | this->get(32);
+	}
+
+	while (bitCount < n) {
+		int ch {ifs.get()};
+		if (ch == EOF)
+			throw runtime_error("Codec::Decoder::get(): truncated stream");
+
+		bits = (bits << 8) | uint64_t(ch);
+		bitCount += 8;
+	}
+
+	bitCount -= n;
+	uint64_t value {(bits >> bitCount) & mask(n)};
+	bits &= mask(bitCount);
+
+	return value;
+}
+
+}
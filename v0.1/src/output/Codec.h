@@ -0,0 +1,168 @@
+// Declarations for Encoder and Decoder classes
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Codec.cpp
+
+#ifndef CODEC_H
+#define CODEC_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<fstream>
+#include<string>
+#include<vector>
+#include<cstdint>
+
+//=============================================================================
+//
+//	Codec
+
+/* lossless compression of time-series field output
+ *
+ * each stream holds one field of one element, written frame by frame,
+ * where a frame is the simulation time followed by the values at all
+ * mesh points
+ *
+ * every value is XOR-ed with the value at the same slot in the previous
+ * frame and the result is stored with the Gorilla scheme
+ * (Pelkonen et al., 2015):
+ *
+ * '0'						- value unchanged
+ * '10' + bits				- meaningful bits fit the previous window
+ * '11' + 5b lead + 6b len + bits	- new window
+ *
+ * file layout:
+ *
+ * magic (4 bytes, "HNC1")
+ * element id, field id, mesh size, frame count (4x uint32)
+ * bit stream (padded to full byte)
+ */
+namespace Codec {
+
+// field identifiers, same order as the csv output
+enum Field {VELOCITY = 0, HEAD, PRESSURE, FRICTION, GAS_FRACTION};
+
+std::string fieldName(const int&);
+	// get file name suffix of field
+
+//=============================================================================
+//	Encoder
+
+class Encoder {
+public:
+	// constructors
+	Encoder();
+	~Encoder();
+
+	// utility
+	void open(const std::string&, const int&, const int&, const int&);
+		// open a stream for
+		//  file name, element id, field id, mesh size
+	void write(const double&, const std::vector<double>&);
+		// encode a frame, time and mesh values
+	void close();
+		// flush bits and finalize header
+
+	// accessors
+	std::uint64_t getRawBytes() const;
+		// get size of frames as plain doubles
+	std::uint64_t getBytes() const;
+		// get size of encoded stream
+
+private:
+	std::ofstream ofs;
+		// output file
+	std::uint32_t meshSize;
+		// number of values per frame
+	std::uint32_t frames;
+		// number of frames written
+	std::vector<std::uint64_t> previous;
+		// previous frame, slot 0 is time
+	std::vector<unsigned char> leading;
+		// leading zeros of window per slot
+	std::vector<unsigned char> trailing;
+		// trailing zeros of window per slot
+	std::vector<unsigned char> buffer;
+		// encoded bytes not yet written
+	std::uint64_t bits;
+		// pending bits
+	int bitCount;
+		// number of pending bits
+	std::uint64_t rawBytes;
+		// size of frames as plain doubles
+	std::uint64_t bytes;
+		// size of encoded stream
+
+	// utility
+	void encode(const double&, const int&);
+		// encode a value at slot
+	void put(const std::uint64_t&, const int&);
+		// append bits to stream
+	void flush(const bool&);
+		// write buffered bytes to file
+};
+
+//=============================================================================
+//	Decoder
+
+class Decoder {
+public:
+	// constructors
+	Decoder(const std::string&);
+	~Decoder();
+
+	// accessors
+	int getElement() const;
+		// get element id
+	int getField() const;
+		// get field id
+	int getMeshSize() const;
+		// get number of values per frame
+	int getFrames() const;
+		// get number of frames
+
+	// utility
+	bool read(double&, std::vector<double>&);
+		// decode next frame
+		// false if no frames are left
+
+private:
+	std::ifstream ifs;
+		// input file
+	std::uint32_t element;
+		// element id
+	std::uint32_t field;
+		// field id
+	std::uint32_t meshSize;
+		// number of values per frame
+	std::uint32_t frames;
+		// number of frames in stream
+	std::uint32_t decoded;
+		// number of frames decoded
+	std::vector<std::uint64_t> previous;
+		// previous frame, slot 0 is time
+	std::vector<unsigned char> leading;
+		// leading zeros of window per slot
+	std::vector<unsigned char> trailing;
+		// trailing zeros of window per slot
+	std::uint64_t bits;
+		// bits read but not yet consumed
+	int bitCount;
+		// number of unconsumed bits
+
+	// utility
+	double decode(const int&);
+		// decode a value at slot
+	std::uint64_t get(const int&);
+		// take bits from stream
+};
+
+}
+
+#endif
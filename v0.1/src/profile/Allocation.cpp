@@ -0,0 +1,44 @@
+// Counting of heap allocations
+//
+// created:	19-10-2026
+// version:	0.1
+//
+// tested:	19-10-2026
+// status:	working
+//
+// last edit:	19-10-2026
+//
+// replaces the global allocation functions, a program
+// counts its allocations only when it links this file;
+// the benchmark harness does, HydNet doesn't, so its
+// allocations never pay for the counter
+
+//=============================================================================
+//
+//	Headers
+
+#include<new>
+#include<cstdlib>
+
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Allocation counting
+
+// array and sized forms forward to these by default
+void* operator new(size_t size)
+{
+	Profile::count(Profile::ALLOCATIONS);
+
+	if (void* p = malloc(size ? size : 1))
+		return p;
+
+	throw bad_alloc {};
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
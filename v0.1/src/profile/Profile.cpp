@@ -0,0 +1,294 @@
+// Definitions for run profiling
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// last edit:	18-10-2026
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<atomic>
+#include<chrono>
+#include<mutex>
+
+#include<sys/resource.h>
+
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//
+//	Profile
+
+namespace Profile {
+
+atomic<bool> enabled {false};
+bool tracing {false};
+int traceInterval {1};
+atomic<long long> counters[COUNTER_QTY] {};
+atomic<long long> nanoseconds[PHASE_QTY] {};
+atomic<long long> calls[PHASE_QTY] {};
+
+// trace storage
+struct Event {
+	const char* name;
+		// static name of event
+	int thread;
+		// index of recording thread
+	long long start;					// [ns]
+		// since epoch
+	long long duration;					// [ns]
+};
+
+static const char* PHASE_NAMES[PHASE_QTY] {
+	"read", "loops", "steady", "hardyCross",
+	"discretize", "transient", "write"
+};
+static const size_t MAX_EVENTS {1000000};
+	// events beyond are dropped
+static const chrono::steady_clock::time_point epoch {
+	chrono::steady_clock::now()};
+	// start of trace
+static vector<Event> events;
+static long long dropped {0};
+static mutex guard;
+static atomic<int> threads {0};
+	// number of threads seen
+
+//	Timer =================================================================
+Timer::Timer(const Phase& p, const bool& t)
+	:phase{p}, traced{t}, start{chrono::steady_clock::now()} {}
+
+Timer::~Timer()
+{
+	auto end = chrono::steady_clock::now();
+	auto elapsed = chrono::duration_cast<chrono::nanoseconds>(
+				   end - start).count();
+
+	nanoseconds[phase].fetch_add(elapsed, memory_order_relaxed);
+	calls[phase].fetch_add(1, memory_order_relaxed);
+
+	if (tracing && traced)
+		trace(PHASE_NAMES[phase], start, end);
+}
+
+//	Span ==================================================================
+Span::Span(const char* n, const bool& t)
+	:name{n}, traced{tracing && t}
+{
+	if (traced)
+		start = chrono::steady_clock::now();
+}
+
+Span::~Span()
+{
+	if (traced)
+		trace(name, start, chrono::steady_clock::now());
+}
+
+//	Utility ===============================================================
+void enable()
+{
+	enabled = true;
+}
+
+void enableTrace(const int& interval)
+{
+	if (interval < 1)
+		throw runtime_error("Profile::enableTrace(): interval");
+
+	tracing = true;
+	traceInterval = interval;
+}
+
+void trace(const char* name, const chrono::steady_clock::time_point& start,
+		const chrono::steady_clock::time_point& end)
+{
+	// small index per thread
+	thread_local int thread {threads++};
+
+	Event e {name, thread,
+			 chrono::duration_cast<chrono::nanoseconds>(start - epoch).count(),
+			 chrono::duration_cast<chrono::nanoseconds>(end - start).count()};
+
+	lock_guard<mutex> lock {guard};
+
+	if (events.size() < MAX_EVENTS)
+		events.push_back(e);
+	else
+		dropped++;
+}
+
+void writeTrace(const string& file)
+	/*
+	 * Chrome trace event format, complete events:
+	 *
+	 * {"traceEvents": [
+	 *   {"name": n, "ph": "X", "pid": 1, "tid": t,
+	 *    "ts": us, "dur": us},
+	 *   ...
+	 * ],
+	 * "otherData": {"stepInterval": n, "droppedEvents": n}}
+	 */
+{
+	ofstream ofs {file};
+	if (!ofs)
+		throw runtime_error("Profile::writeTrace(): "+file);
+
+	lock_guard<mutex> lock {guard};
+
+	ofs << fixed << setprecision(3) << "{\"traceEvents\": [\n";
+
+	// name threads
+	for (int i {0}; i < threads.load(); i++) {
+		ofs << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+			<< "\"tid\": " << i << ", \"args\": {\"name\": \""
+			<< (i == 0 ? "main" : "worker "+to_string(i)) << "\"}},\n";
+	}
+
+	for (unsigned i {0}; i < events.size(); i++) {
+		ofs << "{\"name\": \"" << events[i].name
+			<< "\", \"ph\": \"X\", \"pid\": 1, "
+			<< "\"tid\": " << events[i].thread << ", "
+			<< "\"ts\": " << events[i].start * 1e-3 << ", "
+			<< "\"dur\": " << events[i].duration * 1e-3 << '}'
+			<< (i != events.size()-1 ? ",\n" : "\n");
+	}
+
+	ofs << "],\n\"otherData\": {\"stepInterval\": " << traceInterval
+		<< ", \"droppedEvents\": " << dropped << "}}\n";
+}
+
+double seconds(const Phase& p)
+{
+	return nanoseconds[p].load() * 1e-9;
+}
+
+double setupSeconds()
+{
+	return seconds(READ) + seconds(LOOPS) + seconds(STEADY)
+		 + seconds(DISCRETIZE);
+}
+
+long long peakMemory()
+{
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	// kilobytes on linux
+	return usage.ru_maxrss * 1024LL;
+}
+
+string phaseName(const int& i)
+{
+	if (i < 0 || i >= PHASE_QTY)
+		throw runtime_error("Profile::phaseName(): index");
+
+	return PHASE_NAMES[i];
+}
+
+string counterName(const int& i)
+{
+	switch (i) {
+	case HARDY_CROSS_ITERATIONS:	return "hardyCrossIterations";
+	case COLEBROOK_ITERATIONS:		return "colebrookIterations";
+	case VALVE_ITERATIONS:			return "valveIterations";
+	case STEPS:						return "steps";
+	case MESH_POINTS:				return "meshPoints";
+	case POINT_UPDATES:				return "pointUpdates";
+	case BYTES_WRITTEN:				return "bytesWritten";
+	case ALLOCATIONS:				return "allocations";
+	case ARENA_BYTES:				return "arenaBytes";
+	default:
+		throw runtime_error("Profile::counterName(): index");
+	}
+}
+
+void report(const string& file)
+	/*
+	 * {
+	 *   "phases": {"read": {"seconds": s, "calls": n}, ...},
+	 *   "counters": {"steps": n, ...},
+	 *   "rates": {"pointUpdatesPerSecond": r, ...},
+	 *   "setupSeconds": s,
+	 *   "peakResidentBytes": n
+	 * }
+	 */
+{
+	ofstream ofs {file};
+	if (!ofs)
+		throw runtime_error("Profile::report(): "+file);
+
+	// derived rates, zero if phase did not run
+	auto rate = [](const Counter& c, const Phase& p) {
+		return seconds(p) > 0 ? counters[c].load() / seconds(p) : 0.0;
+	};
+
+	ofs << setprecision(9) << "{\n  \"phases\": {\n";
+	for (int i {0}; i < PHASE_QTY; i++) {
+		ofs << "    \"" << phaseName(i) << "\": {\"seconds\": "
+			<< seconds(Phase(i)) << ", \"calls\": " << calls[i].load() << '}'
+			<< (i != PHASE_QTY-1 ? ",\n" : "\n");
+	}
+
+	ofs << "  },\n  \"counters\": {\n";
+	for (int i {0}; i < COUNTER_QTY; i++) {
+		ofs << "    \"" << counterName(i) << "\": " << counters[i].load()
+			<< (i != COUNTER_QTY-1 ? ",\n" : "\n");
+	}
+
+	ofs << "  },\n  \"rates\": {\n"
+		<< "    \"pointUpdatesPerSecond\": "
+		<< rate(POINT_UPDATES, TRANSIENT) << ",\n"
+		<< "    \"stepsPerSecond\": "
+		<< rate(STEPS, TRANSIENT) << ",\n"
+		<< "    \"hardyCrossIterationsPerSecond\": "
+		<< rate(HARDY_CROSS_ITERATIONS, HARDY_CROSS) << ",\n"
+		<< "    \"bytesWrittenPerSecond\": "
+		<< rate(BYTES_WRITTEN, WRITE) << '\n'
+		<< "  },\n  \"setupSeconds\": " << setupSeconds()
+		<< ",\n  \"peakResidentBytes\": " << peakMemory() << "\n}\n";
+}
+
+ostream& log(ostream& os)
+{
+	os << "\nListing profile:\n\n"
+	   << "|  Phase        |  Time [s]   |  Calls      |\n\n";
+
+	for (int i {0}; i < PHASE_QTY; i++) {
+		os << left
+		   << "|  " << setw(13) << phaseName(i)
+		   << "|  " << scientific << setprecision(3) << setw(11) << seconds(Phase(i))
+		   << "|  " << setw(11) << calls[i].load()
+		   << "|\n";
+	}
+
+	os << "\n|  Counter              |  Value        |\n\n";
+
+	for (int i {0}; i < COUNTER_QTY; i++) {
+		os << left
+		   << "|  " << setw(21) << counterName(i)
+		   << "|  " << setw(13) << counters[i].load()
+		   << "|\n";
+	}
+
+	os << "\n|  Setup time [s]       |  " << scientific << setprecision(3)
+	   << setw(13) << setupSeconds() << "|\n"
+	   << "|  Peak memory [B]      |  " << setw(13) << peakMemory() << "|\n";
+
+	return os;
+}
+
+}
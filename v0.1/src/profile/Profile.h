@@ -0,0 +1,184 @@
+// Declarations for run profiling
+//
+// created:	18-10-2026
+// version:	0.1
+//
+// last edit:	18-10-2026
+//
+// definitions in: Profile.cpp
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+//=============================================================================
+//
+//	Headers
+
+#include<ostream>
+#include<string>
+#include<atomic>
+#include<chrono>
+
+//=============================================================================
+//
+//	Declarations
+
+/* phase timers, counters and trace of a run
+ * - phase timers always run, a phase is timed
+ *   by constructing a Timer in its scope
+ * - counters are only incremented when
+ *   profiling is enabled, a disabled counter
+ *   costs a single branch
+ * - heap allocations are only counted by
+ *   programs linking Allocation.cpp, which
+ *   replaces the global operator new; the
+ *   benchmark harness does, HydNet doesn't
+ * - with several threads phase times are
+ *   summed over threads
+ * - when tracing, timers and spans are recorded
+ *   as Chrome trace events (chrome://tracing,
+ *   ui.perfetto.dev) per thread; untraced
+ *   scopes, eg. unsampled time steps, record
+ *   nothing
+*/
+namespace Profile {
+
+// timed phases
+enum Phase {
+	READ = 0,
+		// Network::read
+	LOOPS,
+		// LoopDepot::build
+	STEADY,
+		// Steady::compute
+	HARDY_CROSS,
+		// Steady::hardyCross
+	DISCRETIZE,
+		// Network::discretize
+	TRANSIENT,
+		// Transient::step
+	WRITE,
+		// Transient::write
+	PHASE_QTY
+};
+
+// counted quantities
+enum Counter {
+	HARDY_CROSS_ITERATIONS = 0,
+	COLEBROOK_ITERATIONS,
+	VALVE_ITERATIONS,
+		// Newton-Raphson iterations at valves
+	STEPS,
+		// transient time steps
+	MESH_POINTS,
+		// mesh points after discretization
+	POINT_UPDATES,
+		// mesh points computed in time steps
+	BYTES_WRITTEN,
+		// size of transient output
+	ALLOCATIONS,
+		// calls to global operator new
+	ARENA_BYTES,
+		// bytes reserved by arenas
+	COUNTER_QTY
+};
+
+extern std::atomic<bool> enabled;
+	// counters are incremented, read by
+	//  allocations on any thread
+extern bool tracing;
+	// trace events are recorded
+extern int traceInterval;
+	// trace every n-th time step
+extern std::atomic<long long> counters[COUNTER_QTY];
+	// counter values
+extern std::atomic<long long> nanoseconds[PHASE_QTY];
+	// time spent in phases
+extern std::atomic<long long> calls[PHASE_QTY];
+	// number of timed scopes per phase
+
+// scoped phase timer
+class Timer {
+public:
+	// constructors
+	Timer(const Phase&, const bool& = true);
+		// start timing, optionally traced
+	~Timer();
+		// add elapsed time to phase
+
+	Timer(const Timer&) = delete;
+	Timer& operator= (const Timer&) = delete;
+
+private:
+	Phase phase;
+		// timed phase
+	bool traced;
+		// record a trace event
+	std::chrono::steady_clock::time_point start;
+		// time of construction
+};
+
+// scoped trace event
+// - does nothing unless tracing
+class Span {
+public:
+	// constructors
+	Span(const char*, const bool& = true);
+		// start span with a static name
+	~Span();
+		// record trace event
+
+	Span(const Span&) = delete;
+	Span& operator= (const Span&) = delete;
+
+private:
+	const char* name;
+		// name of event
+	bool traced;
+		// record a trace event
+	std::chrono::steady_clock::time_point start;
+		// time of construction
+};
+
+// counting
+inline void count(const Counter& c, const long long& n = 1)
+{
+	if (enabled.load(std::memory_order_relaxed))
+		counters[c].fetch_add(n, std::memory_order_relaxed);
+}
+
+// sampling
+inline bool sampled(const int& step)
+{
+	return tracing && step % traceInterval == 0;
+}
+
+// utility
+void enable();
+	// enable counters
+void enableTrace(const int&);
+	// enable tracing every n-th step
+void trace(const char*, const std::chrono::steady_clock::time_point&,
+		const std::chrono::steady_clock::time_point&);
+	// record a trace event
+void writeTrace(const std::string&);
+	// write Chrome trace to file
+double seconds(const Phase&);
+	// time spent in phase [s]
+double setupSeconds();
+	// time spent reading, building loops,
+	//  solving steady state and discretizing [s]
+long long peakMemory();
+	// peak resident set size [B]
+std::string phaseName(const int&);
+	// name of phase in report
+std::string counterName(const int&);
+	// name of counter in report
+void report(const std::string&);
+	// write json report to file
+std::ostream& log(std::ostream&);
+	// log output
+
+}
+
+#endif
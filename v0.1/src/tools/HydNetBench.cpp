@@ -0,0 +1,627 @@
+// Benchmark harness for HydNet kernels
+//
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// usage:
+//
+// 	HydNetBench [key=value ...]
+//
+// keys:
+//
+// 	sizes		ladder of core network sizes in pipes	(20,50,100)
+// 	type		generator topology			(grid)
+// 	warmup		untimed repetitions			(1)
+// 	reps		timed repetitions			(5)
+// 	steps		time steps per repetition		(20)
+// 	out		json report				(bench.json)
+// 	baseline	json report to check against		(none)
+// 	tolerance	allowed relative slowdown of median	(0.25)
+// 	floor		shortest baseline median timed [s]	(1e-3)
+//
+// networks are generated by HydNetGenerate with a fixed seed
+// into benchmarks/<type>_<size>, so results of the same keys
+// are comparable across commits. Each kernel reports median,
+// p95 and minimum wall time per repetition and the counters
+// of one repetition, which are deterministic.
+//
+// with a baseline the run is a performance check: counters
+// must match the baseline exactly, a kernel is slower when
+// its median exceeds the baseline median by more than the
+// tolerance and so does its fastest repetition, which is
+// least disturbed by other load; any failure exits with
+// status 1; kernels faster than the floor are dominated by
+// timer and cache noise, only their counters are checked
+//
+// loopDepotUpdate closes and reopens random pipes, with at
+// most a few closed at once; before timing, the loops after
+// every edit are verified against a full rebuild, 'make check'
+// runs the same verification on networks with bridges,
+// parallel pipes and several reservoirs
+
+//=============================================================================
+//	Headers
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<functional>
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<cstdlib>
+#include<climits>
+#include<random>
+
+#include<unistd.h>
+
+#include"Dense"
+#include"Network.h"
+#include"LoopDepot.h"
+#include"Element.h"
+#include"steadyState.h"
+#include"ensemble.h"
+#include"transientState.h"
+#include"Codec.h"
+#include"Profile.h"
+using namespace std;
+
+//=============================================================================
+//	Declarations
+
+// harness parameters
+struct Parameters {
+	vector<int> sizes {20, 50, 100};
+	string type {"grid"};
+	int warmup {1};
+	int reps {5};
+	int steps {20};
+	string out {"bench.json"};
+	string baseline {""};
+	double tolerance {0.25};
+	double floor {1e-3};
+};
+
+// incremental loop updates
+const int EDITS {20};
+	// edits per repetition
+const int MAX_CLOSED {3};
+	// pipes closed at once
+
+// result of a kernel
+struct Result {
+	string kernel;
+	int pipes;
+		// pipes in network
+	int ops;
+		// operations per repetition
+	double median;						// [s]
+	double p95;							// [s]
+	double min;							// [s]
+	vector<long long> counters;
+		// Profile counters of one repetition
+};
+
+Parameters parse(int, char*[]);
+	// read key=value arguments
+string generate(const Parameters&, const int&);
+	// generate network, returns directory
+Result measure(const Parameters&, const string&, const int&, const int&,
+		const function<void()>&, const function<void()>& = [](){});
+	// time a kernel, the second function
+	//  prepares each repetition untimed
+void benchSize(const Parameters&, const int&, vector<Result>&);
+	// run all kernels on one network
+vector<int> edits(const Network&);
+	// random pipes to close or reopen
+void report(const Parameters&, const vector<Result>&);
+	// write json report
+vector<Result> read(const Parameters&);
+	// read baseline report
+int check(const Parameters&, const vector<Result>&);
+	// compare with baseline, returns
+	//  number of failures
+string field(const string&, const string&);
+	// value of a json key in a line
+ostream& log(ostream&, const Result&);
+	// log output
+
+//=============================================================================
+//	Main program
+
+int main(int argc, char* argv[])
+try {
+	Parameters par {parse(argc, argv)};
+	vector<Result> results;
+
+	// counters are part of the results
+	Profile::enable();
+
+	cout << "|  Kernel              |  Pipes   |  Ops     |  Median [s] |"
+		 << "   p95 [s]   |   Min [s]   |\n\n";
+
+	for (int size : par.sizes) {
+		benchSize(par, size, results);
+	}
+
+	report(par, results);
+
+	// performance check
+	if (!par.baseline.empty()) {
+		int failures {check(par, results)};
+
+		if (failures != 0) {
+			cerr << "\nPERFORMANCE CHECK FAILED: " << failures
+				 << " regression(s) against " << par.baseline << '\n';
+			return 1;
+		}
+		cout << "\nPerformance check passed against " << par.baseline << '\n';
+	}
+}
+catch (runtime_error& e) {
+	cerr << "runtime_error: error: " << e.what() << '\n';
+	return 1;
+}
+catch (exception& e) {
+	cerr << "error: " << e.what() << '\n';
+	return 1;
+}
+
+//=============================================================================
+//	Definitions
+
+Parameters parse(int argc, char* argv[])
+{
+	Parameters par;
+
+	for (int i {1}; i < argc; i++) {
+		string arg {argv[i]};
+		unsigned long pos {arg.find('=')};
+
+		if (pos == string::npos)
+			throw runtime_error("parse(): "+arg);
+
+		string key {arg.substr(0, pos)};
+		string value {arg.substr(pos+1)};
+
+		if (key == "sizes") {
+			par.sizes.clear();
+			istringstream iss {value};
+			string s;
+			while (getline(iss, s, ',')) {
+				par.sizes.push_back(stoi(s));
+			}
+		}
+		else if (key == "type")
+			par.type = value;
+		else if (key == "warmup")
+			par.warmup = stoi(value);
+		else if (key == "reps")
+			par.reps = stoi(value);
+		else if (key == "steps")
+			par.steps = stoi(value);
+		else if (key == "out")
+			par.out = value;
+		else if (key == "baseline")
+			par.baseline = value;
+		else if (key == "tolerance")
+			par.tolerance = stod(value);
+		else if (key == "floor")
+			par.floor = stod(value);
+		else
+			throw runtime_error("parse(): "+key);
+	}
+
+	if (par.sizes.empty() || par.warmup < 0 || par.reps < 1 || par.steps < 1
+	 || par.tolerance < 0 || par.floor < 0)
+		throw runtime_error("parse(): invalid");
+
+	return par;
+}
+
+string generate(const Parameters& par, const int& size)
+{
+	string dir {"benchmarks/"+par.type+"_"+to_string(size)};
+	string cmd {"mkdir -p "+dir+" && ./HydNetGenerate type="+par.type
+				+" pipes="+to_string(size)+" loops=0.3 seed=1 symtime=1"
+				+" dir="+dir+" > /dev/null"};
+
+	if (system(cmd.c_str()) != 0)
+		throw runtime_error("generate(): "+cmd);
+
+	return dir;
+}
+
+Result measure(const Parameters& par, const string& kernel, const int& pipes,
+		const int& ops, const function<void()>& run,
+		const function<void()>& prepare)
+{
+	Result r {kernel, pipes, ops, 0, 0, 0, {}};
+	vector<double> times;
+
+	for (int i {0}; i < par.warmup + par.reps; i++) {
+		prepare();
+
+		// counters of the last repetition
+		for (int j {0}; j < Profile::COUNTER_QTY; j++) {
+			Profile::counters[j] = 0;
+		}
+
+		auto start = chrono::steady_clock::now();
+		run();
+		double t {chrono::duration<double>(
+				  chrono::steady_clock::now() - start).count()};
+
+		if (i >= par.warmup)
+			times.push_back(t);
+	}
+
+	for (int j {0}; j < Profile::COUNTER_QTY; j++) {
+		r.counters.push_back(Profile::counters[j].load());
+	}
+
+	// nearest rank statistics
+	sort(times.begin(), times.end());
+	int n {int(times.size())};
+
+	r.min = times[0];
+	r.median = n % 2 ? times[n/2] : (times[n/2-1] + times[n/2]) / 2;
+	r.p95 = times[min(n-1, int(ceil(0.95 * n)) - 1)];
+
+	log(cout, r);
+
+	return r;
+}
+
+void benchSize(const Parameters& par, const int& size, vector<Result>& results)
+{
+	string dir {generate(par, size)};
+
+	// inputs are read from the working directory
+	char home[4096];
+	if (!getcwd(home, sizeof(home)) || chdir(dir.c_str()) != 0)
+		throw runtime_error("benchSize(): "+dir);
+
+	Network base {};
+	int pipes {base.getElementQty()};
+
+	// reading, linking and teardown
+	results.push_back(measure(par, "networkRead", pipes, 1,
+		[&]() { Network net {}; }));
+	const Fluid& fluid {base.settings.fluid};
+
+	// loop generation
+	results.push_back(measure(par, "loopDepotBuild", pipes, 1,
+		[&]() { LoopDepot depot {base}; }));
+
+	LoopDepot depot {base};
+
+	// incremental updates, verified once
+	vector<int> toggle {edits(base)};
+	LoopDepot* update {new LoopDepot {depot, base}};
+
+	for (int id : toggle) {
+		if (update->isClosed(id))
+			update->open(base, id);
+		else
+			update->close(base, id);
+		update->verify(base);
+	}
+
+	results.push_back(measure(par, "loopDepotUpdate", pipes, EDITS,
+		[&]() {
+			for (int id : toggle) {
+				if (update->isClosed(id))
+					update->open(base, id);
+				else
+					update->close(base, id);
+			}
+		},
+		[&]() { delete update; update = new LoopDepot {depot, base}; }));
+	delete update;
+
+	// steady state
+	Network steady {base};
+	LoopDepot steadyDepot {depot, steady};
+
+	results.push_back(measure(par, "steadyCompute", pipes, 1,
+		[&]() { Steady::compute(steady, steadyDepot,
+				Ensemble::threadCount(steady.settings, INT_MAX), NULL); },
+		[&]() {
+			for (int i {1}; i <= steady.getElementQty(); i++)
+				steady.getElement(i)->setFlow(base.getElement(i)->getFlow());
+		}));
+
+	Steady::compute(base, depot, Ensemble::threadCount(base.settings, INT_MAX),
+			NULL);
+
+	// friction and head loss of every element
+	results.push_back(measure(par, "friction", pipes, pipes * par.steps,
+		[&]() {
+			for (int j {0}; j < par.steps; j++)
+				for (int i {1}; i <= base.getElementQty(); i++)
+					base.getElement(i)->computeHeadLossC(fluid);
+		}));
+
+	// Hardy-Cross iterations, all loops as one block
+	int loops {depot.getLNum() + depot.getPNum()};
+	vector<int> all (loops);
+	for (int i {0}; i < loops; i++)
+		all[i] = i+1;
+
+	Steady::Incidence inc;
+	Steady::incidence(base, depot, all, inc);
+	Eigen::MatrixXd A (loops, loops);
+	Eigen::VectorXd b (loops);
+	Steady::Pool serial {1};
+
+	results.push_back(measure(par, "steadyFill", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++)
+				Steady::assemble(fluid, inc, serial, A, b);
+		}));
+
+	results.push_back(measure(par, "steadySolve", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++)
+				Eigen::VectorXd x {A.selfadjointView<Eigen::Lower>().ldlt().solve(b)};
+		}));
+
+	// discretization of a fresh copy
+	Network* mesh {NULL};
+
+	results.push_back(measure(par, "discretize", pipes, 1,
+		[&]() { mesh->discretize(); },
+		[&]() { delete mesh; mesh = new Network {base}; }));
+
+	// transient kernels, repeated sweeps are idempotent
+	//  without a mesh update
+	Element* e {mesh->getElement(1)};
+
+	results.push_back(measure(par, "elementTransient", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++)
+				e->computeTransient(mesh->settings, 1);
+		}));
+
+	results.push_back(measure(par, "networkStep", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++) {
+				Transient::step(*mesh, i);
+				Transient::update(*mesh, i);
+			}
+		}));
+
+	// writing
+	ofstream* ofs {new ofstream [5 * mesh->getElementQty()]};
+	Transient::constructFiles(ofs, *mesh);
+
+	results.push_back(measure(par, "writeCsv", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++)
+				Transient::write(ofs, *mesh);
+		}));
+	delete[] ofs;
+
+	Codec::Encoder* enc {new Codec::Encoder [5 * mesh->getElementQty()]};
+	Transient::constructFiles(enc, *mesh);
+
+	results.push_back(measure(par, "writeCompressed", pipes, par.steps,
+		[&]() {
+			for (int i {0}; i < par.steps; i++)
+				Transient::write(enc, *mesh);
+		}));
+	delete[] enc;
+
+	delete mesh;
+
+	if (chdir(home) != 0)
+		throw runtime_error("benchSize(): "+string(home));
+}
+
+vector<int> edits(const Network& net)
+	// toggle sequence, pipes are reopened
+	//  at random or when too many are closed
+{
+	mt19937 rng {1};
+	vector<int> sequence {};
+	vector<int> closed {};
+	int id;
+
+	while (int(sequence.size()) < EDITS) {
+		if (!closed.empty()
+		 && (int(closed.size()) == MAX_CLOSED || rng() % 2 == 0)) {
+			// reopen
+			int i {int(rng() % closed.size())};
+			id = closed[i];
+			closed.erase(closed.begin()+i);
+		}
+		else {
+			// close an open pipe
+			id = int(rng() % net.getElementQty()) + 1;
+			if (find(closed.begin(), closed.end(), id) != closed.end())
+				continue;
+			closed.push_back(id);
+		}
+		sequence.push_back(id);
+	}
+
+	return sequence;
+}
+
+void report(const Parameters& par, const vector<Result>& results)
+	/*
+	 * {
+	 *   "type": t, "warmup": n, "reps": n, "steps": n,
+	 *   "peakResidentBytes": n,
+	 *   "results": [
+	 *     {"kernel": k, "pipes": n, "ops": n, "median": s,
+	 *      "p95": s, "min": s, "counters": {...}},
+	 *     ...
+	 *   ]
+	 * }
+	 */
+{
+	ofstream ofs {par.out};
+	if (!ofs)
+		throw runtime_error("report(): "+par.out);
+
+	ofs << setprecision(6) << scientific
+		<< "{\n  \"type\": \"" << par.type << "\", \"warmup\": " << par.warmup
+		<< ", \"reps\": " << par.reps << ", \"steps\": " << par.steps
+		<< ",\n  \"peakResidentBytes\": " << Profile::peakMemory()
+		<< ",\n  \"results\": [\n";
+
+	for (unsigned i {0}; i < results.size(); i++) {
+		const Result& r {results[i]};
+
+		ofs << "    {\"kernel\": \"" << r.kernel << "\", \"pipes\": " << r.pipes
+			<< ", \"ops\": " << r.ops << ", \"median\": " << r.median
+			<< ", \"p95\": " << r.p95 << ", \"min\": " << r.min
+			<< ", \"counters\": {";
+
+		for (int j {0}; j < Profile::COUNTER_QTY; j++) {
+			ofs << '"' << Profile::counterName(j) << "\": " << r.counters[j]
+				<< (j != Profile::COUNTER_QTY-1 ? ", " : "");
+		}
+		ofs << "}}" << (i != results.size()-1 ? ",\n" : "\n");
+	}
+
+	ofs << "  ]\n}\n";
+}
+
+vector<Result> read(const Parameters& par)
+	// reads reports as written by report()
+{
+	ifstream ifs {par.baseline};
+	if (!ifs)
+		throw runtime_error("read(): "+par.baseline);
+
+	vector<Result> baseline;
+	string line;
+
+	while (getline(ifs, line)) {
+		// header, runs must be alike
+		if (line.find("\"reps\"") != string::npos) {
+			if (field(line, "type") != "\""+par.type+"\""
+			 || stoi(field(line, "warmup")) != par.warmup
+			 || stoi(field(line, "reps")) != par.reps
+			 || stoi(field(line, "steps")) != par.steps)
+				throw runtime_error("read(): parameters differ from "
+									+par.baseline);
+		}
+		// result
+		else if (line.find("\"kernel\"") != string::npos) {
+			string kernel {field(line, "kernel")};
+
+			Result r {kernel.substr(1, kernel.size()-2),
+					  stoi(field(line, "pipes")), stoi(field(line, "ops")),
+					  stod(field(line, "median")), stod(field(line, "p95")),
+					  stod(field(line, "min")), {}};
+
+			for (int j {0}; j < Profile::COUNTER_QTY; j++) {
+				string value {field(line, Profile::counterName(j))};
+				// counters missing in older baselines never match
+				r.counters.push_back(value.empty() ? -1 : stoll(value));
+			}
+
+			baseline.push_back(r);
+		}
+	}
+
+	if (baseline.empty())
+		throw runtime_error("read(): empty "+par.baseline);
+
+	return baseline;
+}
+
+int check(const Parameters& par, const vector<Result>& results)
+{
+	vector<Result> baseline {read(par)};
+	int failures {0};
+
+	cout << "\nChecking against " << par.baseline << ":\n\n"
+		 << "|  Kernel              |  Pipes   |  Median/base  |  Status\n\n";
+
+	for (const Result& b : baseline) {
+		// find current result
+		auto r = find_if(results.begin(), results.end(),
+			[&](const Result& x) {
+				return x.kernel == b.kernel && x.pipes == b.pipes;
+			});
+
+		cout << left << "|  " << setw(20) << b.kernel
+			 << "|  " << setw(8) << b.pipes << "|  ";
+
+		if (r == results.end()) {
+			cout << setw(14) << "-" << "|  missing\n";
+			failures++;
+			continue;
+		}
+
+		double ratio {r->median / b.median};
+		string status {"ok"};
+
+		// counters are deterministic
+		for (int j {0}; j < Profile::COUNTER_QTY; j++) {
+			if (r->counters[j] != b.counters[j]) {
+				status = "COUNTER " + Profile::counterName(j) + " "
+						 + to_string(b.counters[j]) + " -> "
+						 + to_string(r->counters[j]);
+				failures++;
+				break;
+			}
+		}
+
+		// timings are noisy
+		if (b.median < par.floor) {
+			status += " (untimed)";
+		}
+		else if (ratio > 1 + par.tolerance
+			  && r->min > b.min * (1 + par.tolerance)) {
+			status = (status == "ok" ? "" : status + ", ") + "SLOWER";
+			failures++;
+		}
+
+		cout << fixed << setprecision(3) << setw(14) << ratio
+			 << "|  " << status << '\n';
+	}
+
+	return failures;
+}
+
+string field(const string& line, const string& key)
+	// returns raw value, strings keep their quotes
+{
+	string tag {"\""+key+"\": "};
+	unsigned long pos {line.find(tag)};
+
+	if (pos == string::npos)
+		return "";
+
+	pos += tag.size();
+	unsigned long end {line.find_first_of(",}", pos)};
+
+	return line.substr(pos, end - pos);
+}
+
+ostream& log(ostream& os, const Result& r)
+{
+	os << left
+	   << "|  " << setw(20) << r.kernel
+	   << "|  " << setw(8) << r.pipes
+	   << "|  " << setw(8) << r.ops
+	   << scientific << setprecision(3)
+	   << "|  " << setw(11) << r.median
+	   << "|  " << setw(11) << r.p95
+	   << "|  " << setw(11) << r.min
+	   << "|\n";
+
+	return os;
+}
@@ -0,0 +1,260 @@
+// Consistency check of incremental loop updates
+//
+// version:	0.1
+//
+// tested:	19-10-2026
+// status:	working
+//
+// usage:
+//
+// 	HydNetCheck
+//
+// small networks with bridges, parallel pipes and several
+// reservoirs are written to a scratch directory and read
+// back. Every pipe is closed and reopened on its own, then
+// random pipes are toggled with at most a few closed at
+// once; after every edit LoopDepot::verify() compares the
+// loops with a full rebuild. Any mismatch exits with
+// status 1.
+
+//=============================================================================
+//	Headers
+
+#include<iostream>
+#include<fstream>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<utility>
+#include<algorithm>
+#include<cstdlib>
+#include<random>
+
+#include<unistd.h>
+
+#include"Network.h"
+#include"LoopDepot.h"
+using namespace std;
+
+//=============================================================================
+//	Declarations
+
+// network of a check
+struct Case {
+	string name;
+	int nodeQty;
+	vector<pair<int, int>> pipes;
+		// start and end node of each pipe
+	vector<int> reservoirs;
+		// fixed head nodes
+};
+
+// random toggles
+const int EDITS {200};
+	// edits per case
+const int MAX_CLOSED {3};
+	// pipes closed at once
+
+vector<Case> cases();
+	// networks to check
+Case grid(const int&, const int&);
+	// rows x columns grid, reservoirs at corners
+void write(const Case&);
+	// write input files to working directory
+int check(const Case&);
+	// toggle pipes and verify, returns edits
+
+//=============================================================================
+//	Main program
+
+int main()
+try {
+	// inputs are read from the working directory
+	char home[4096];
+	char scratch[] {"/tmp/HydNetCheck.XXXXXX"};
+	if (!getcwd(home, sizeof(home)) || !mkdtemp(scratch)
+	 || chdir(scratch) != 0)
+		throw runtime_error("main(): scratch directory");
+
+	int failures {0};
+
+	for (const Case& c : cases()) {
+		try {
+			int edits {check(c)};
+			cout << "loops " << c.name << ": " << edits << " edits verified\n";
+		}
+		catch (runtime_error& e) {
+			cerr << "loops " << c.name << ": " << e.what() << '\n';
+			failures++;
+		}
+	}
+
+	if (chdir(home) != 0 || system(("rm -rf "+string(scratch)).c_str()) != 0)
+		throw runtime_error("main(): scratch directory");
+
+	if (failures != 0) {
+		cerr << "\nCHECK FAILED: " << failures << " case(s)\n";
+		return 1;
+	}
+	cout << "\nCheck passed\n";
+}
+catch (runtime_error& e) {
+	cerr << "runtime_error: error: " << e.what() << '\n';
+	return 1;
+}
+catch (exception& e) {
+	cerr << "error: " << e.what() << '\n';
+	return 1;
+}
+
+//=============================================================================
+//	Definitions
+
+vector<Case> cases()
+{
+	vector<Case> list {};
+
+	// two squares joined by a bridge, a dead end
+	//  and a square without fixed heads
+	list.push_back({"bridges", 14,
+		{{1, 2}, {2, 3}, {3, 4}, {4, 1}, {3, 5}, {5, 6}, {6, 7}, {7, 8},
+		 {8, 5}, {7, 9}, {9, 10}, {2, 11}, {11, 12}, {12, 13}, {13, 14},
+		 {14, 11}},
+		{1, 10}});
+
+	// parallel pipes in a loop and on a bridge
+	list.push_back({"parallel", 6,
+		{{1, 2}, {1, 2}, {1, 2}, {2, 3}, {3, 4}, {3, 4}, {4, 1}, {4, 5},
+		 {4, 5}, {5, 6}},
+		{1, 6}});
+
+	// reservoirs on every corner, one pair
+	//  joined by parallel pipes
+	list.push_back(grid(4, 5));
+	list.back().name = "reservoirs";
+	list.back().pipes.push_back(list.back().pipes.back());
+
+	return list;
+}
+
+Case grid(const int& rows, const int& columns)
+{
+	Case c {"grid", rows*columns, {}, {}};
+
+	// node of row and column, from 0
+	auto node = [&columns](const int& i, const int& j) {
+		return i*columns + j + 1;
+	};
+
+	for (int i {0}; i < rows; i++) {
+		for (int j {0}; j < columns; j++) {
+			if (j+1 < columns)
+				c.pipes.push_back({node(i, j), node(i, j+1)});
+			if (i+1 < rows)
+				c.pipes.push_back({node(i, j), node(i+1, j)});
+		}
+	}
+
+	// each reservoir on its own pipe
+	int corners[4][2] {{0, 0}, {0, columns-1}, {rows-1, 0},
+					   {rows-1, columns-1}};
+	for (int k {0}; k < 4; k++) {
+		c.nodeQty++;
+		c.pipes.push_back({node(corners[k][0], corners[k][1]), c.nodeQty});
+		c.reservoirs.push_back(c.nodeQty);
+	}
+
+	return c;
+}
+
+void write(const Case& c)
+{
+	ofstream elements {"elements"};
+	ofstream nodes {"nodes"};
+	ofstream settings {"settings"};
+	if (!elements || !nodes || !settings)
+		throw runtime_error("write(): "+c.name);
+
+	elements << "// Check " << c.name << " - element file\n\n"
+			 << "nodeQty:\t" << c.nodeQty << ";\n"
+			 << "elementQty:\t" << c.pipes.size() << ";\n\n{\n";
+
+	for (unsigned i {0}; i < c.pipes.size(); i++) {
+		elements << "\t{\n"
+				 << "\tid:\t\t\t" << i+1 << ";\n"
+				 << "\tstart:\t\t" << c.pipes[i].first << ";\n"
+				 << "\tend:\t\t" << c.pipes[i].second << ";\n"
+				 << "\tdiameter:\t0.1;\n"
+				 << "\tlength:\t\t100;\n"
+				 << "\tthickness:\t0.005;\n"
+				 << "\troughness:\t1.5e-6;\n"
+				 << "\tmaterial:\tsteel;\n"
+				 << "\t}\n";
+	}
+	elements << "}\n";
+
+	// levels differ so that reservoirs exchange water
+	nodes << "// Check " << c.name << " - node file\n\nReservoir\n{\n";
+	for (unsigned i {0}; i < c.reservoirs.size(); i++) {
+		nodes << "\t{\n"
+			  << "\tid:\t\t\t" << c.reservoirs[i] << ";\n"
+			  << "\tpressure:\t1e5;\n"
+			  << "\tlevel:\t\t" << 20 + 5*i << ";\n"
+			  << "\t}\n";
+	}
+	nodes << "}\n";
+
+	settings << "// Check " << c.name << " - general\n\n"
+			 << "{\n"
+			 << "\tfluid:\t\t\t\twater;\n"
+			 << "\tdiscretization:\t\t1;\n"
+			 << "\tsymTime:\t\t\t1;\n"
+			 << "}\n";
+}
+
+int check(const Case& c)
+{
+	write(c);
+
+	Network net {};
+	LoopDepot depot {net};
+	int edits {0};
+
+	depot.verify(net);
+
+	// every pipe alone
+	for (int id {1}; id <= net.getElementQty(); id++) {
+		depot.close(net, id);
+		depot.verify(net);
+		depot.open(net, id);
+		depot.verify(net);
+		edits += 2;
+	}
+
+	// random pipes, reopened at random or
+	//  when too many are closed
+	mt19937 rng {1};
+	vector<int> closed {};
+	int id;
+
+	while (edits < 2*net.getElementQty() + EDITS) {
+		if (!closed.empty()
+		 && (int(closed.size()) == MAX_CLOSED || rng() % 2 == 0)) {
+			int i {int(rng() % closed.size())};
+			id = closed[i];
+			closed.erase(closed.begin()+i);
+			depot.open(net, id);
+		}
+		else {
+			id = int(rng() % net.getElementQty()) + 1;
+			if (find(closed.begin(), closed.end(), id) != closed.end())
+				continue;
+			closed.push_back(id);
+			depot.close(net, id);
+		}
+		depot.verify(net);
+		edits++;
+	}
+
+	return edits;
+}
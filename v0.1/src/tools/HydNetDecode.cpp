@@ -0,0 +1,103 @@
+// Decoder for compressed HydNet output
+//
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// usage:
+//
+// 	HydNetDecode el_1_v.hnc [el_1_H.hnc ...]
+//
+// each stream is written next to its source as a .csv file
+// in the same format as the plain text output
+
+//=============================================================================
+//	Headers
+
+#include<iostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+#include"Codec.h"
+using namespace std;
+
+//=============================================================================
+//	Declarations
+
+string csvName(const string&);
+	// replace .hnc extension with .csv
+int decode(const string&);
+	// decode a stream to csv
+	// returns number of frames
+
+//=============================================================================
+//	Main program
+
+int main(int argc, char* argv[])
+try {
+	if (argc < 2) {
+		cerr << "usage: " << argv[0] << " file.hnc [file.hnc ...]\n";
+		return 1;
+	}
+
+	for (int i {1}; i < argc; i++) {
+		int frames {decode(argv[i])};
+		cout << argv[i] << ": " << frames << " frames\n";
+	}
+}
+catch (runtime_error& e) {
+	cerr << "runtime_error: error: " << e.what() << '\n';
+	return 1;
+}
+catch (...) {
+	cerr << "unidentified error\n";
+	return 1;
+}
+
+//=============================================================================
+//	Definitions
+
+string csvName(const string& file)
+{
+	string base {file};
+	string ext {".hnc"};
+
+	if (base.size() > ext.size()
+	 && base.compare(base.size()-ext.size(), ext.size(), ext) == 0)
+		base.erase(base.size()-ext.size());
+
+	return base+".csv";
+}
+
+int decode(const string& file)
+{
+	Codec::Decoder dec {file};
+
+	ofstream ofs {csvName(file)};
+	if (!ofs)
+		throw runtime_error("decode(): "+csvName(file));
+
+	double time {0};
+	vector<double> values {};
+	int frames {0};
+
+	ofs << setprecision(9) << fixed;
+
+	while (dec.read(time, values)) {
+		for (int i {0}; i < dec.getMeshSize(); i++) {
+			ofs << values[i];
+
+			if (i != dec.getMeshSize()-1)
+				ofs << ',';
+		}
+		ofs << ',' << time << '\n';
+
+		frames++;
+	}
+
+	return frames;
+}
@@ -0,0 +1,516 @@
+// Generator of synthetic HydNet input
+//
+// version:	0.1
+//
+// tested:	18-10-2026
+// status:	working
+//
+// usage:
+//
+// 	HydNetGenerate type=grid [key=value ...]
+//
+// writes 'elements', 'nodes' and 'settings' input files
+//
+// keys:
+//
+// 	type		grid, geometric, tree or line
+// 	pipes		number of pipes in the core network	(100)
+// 	loops		fraction of candidate loop closing	(0.5)
+// 			 pipes kept, grid and geometric only
+// 	length		pipe length range min:max [m]		(50:200)
+// 	lengthdist	uniform or loguniform			(uniform)
+// 	reservoirs	number of reservoirs			(2)
+// 	demands		fraction of core nodes with demand	(0.1)
+// 	discharge	demand per demand node [m3s-1]		(1e-4)
+// 	valves		line only, a valve every n pipes	(10)
+// 	diameter	pipe diameter [m]			(0.1)
+// 	symtime		simulation time [s]			(1)
+// 	discretization	minimum segments per pipe		(1)
+// 	seed		random seed				(1)
+// 	dir		output directory			(.)
+//
+// reservoirs and demand sources are boundary nodes, each is
+// attached to a core node by an extra pipe; output is fully
+// determined by the keys, including seed
+
+//=============================================================================
+//	Headers
+
+#include<iostream>
+#include<fstream>
+#include<iomanip>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<utility>
+#include<algorithm>
+#include<cmath>
+#include<cstdint>
+
+using namespace std;
+
+//=============================================================================
+//	Declarations
+
+// generator parameters
+struct Parameters {
+	string type {""};
+	int pipes {100};
+	double loops {0.5};
+	double lengthMin {50};
+	double lengthMax {200};
+	string lengthDist {"uniform"};
+	int reservoirs {2};
+	double demands {0.1};
+	double discharge {1e-4};
+	int valves {10};
+	double diameter {0.1};
+	double symTime {1};
+	int discretization {1};
+	uint64_t seed {1};
+	string dir {"."};
+};
+
+// portable random numbers
+// - xorshift64*, same sequence on every platform
+class Random {
+public:
+	Random(const uint64_t&);
+	double uniform();
+		// in [0, 1)
+	int index(const int&);
+		// in [0, n)
+private:
+	uint64_t state;
+};
+
+// generated network
+// - node ids start at 1
+struct Graph {
+	int nodeQty {0};
+	vector<pair<int, int>> pipes;
+		// start and end node
+	vector<int> reservoirs;
+		// boundary nodes with fixed pressure
+	vector<int> demands;
+		// boundary nodes with negative discharge
+	vector<int> valves;
+		// in line valves
+};
+
+Parameters parse(int, char*[]);
+	// read key=value arguments
+void grid(const Parameters&, Random&, Graph&);
+	// rectangular grid
+void geometric(const Parameters&, Random&, Graph&);
+	// random geometric graph in a unit square
+void tree(const Parameters&, Random&, Graph&);
+	// branched random tree
+void line(const Parameters&, Random&, Graph&);
+	// transmission line with valves
+void attach(const Parameters&, Random&, Graph&);
+	// attach reservoirs and demands
+double pipeLength(const Parameters&, Random&);
+	// draw a pipe length
+void writeElements(const Parameters&, Random&, const Graph&);
+void writeNodes(const Parameters&, Random&, const Graph&);
+void writeSettings(const Parameters&);
+
+//=============================================================================
+//	Main program
+
+int main(int argc, char* argv[])
+try {
+	Parameters par {parse(argc, argv)};
+	Random rnd {par.seed};
+	Graph g;
+
+	// core network
+	if (par.type == "grid")
+		grid(par, rnd, g);
+	else if (par.type == "geometric")
+		geometric(par, rnd, g);
+	else if (par.type == "tree")
+		tree(par, rnd, g);
+	else if (par.type == "line")
+		line(par, rnd, g);
+	else
+		throw runtime_error("main(): type");
+
+	// boundary nodes
+	attach(par, rnd, g);
+
+	writeElements(par, rnd, g);
+	writeNodes(par, rnd, g);
+	writeSettings(par);
+
+	cout << par.type << ": " << g.nodeQty << " nodes, "
+		 << g.pipes.size() << " pipes, "
+		 << g.pipes.size() + 1 - g.nodeQty << " loops, "
+		 << g.reservoirs.size() << " reservoirs, "
+		 << g.demands.size() << " demands, "
+		 << g.valves.size() << " valves\n";
+}
+catch (runtime_error& e) {
+	cerr << "runtime_error: error: " << e.what() << '\n';
+	return 1;
+}
+catch (exception& e) {
+	cerr << "error: " << e.what() << '\n';
+	return 1;
+}
+
+//=============================================================================
+//	Definitions
+
+Random::Random(const uint64_t& seed)
+	:state{seed * 0x9E3779B97F4A7C15ULL + 1} {}
+
+double Random::uniform()
+{
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+
+	// 53 significant bits
+	return ldexp(double((state * 0x2545F4914F6CDD1DULL) >> 11), -53);
+}
+
+int Random::index(const int& n)
+{
+	return min(n-1, int(this->uniform() * n));
+}
+
+Parameters parse(int argc, char* argv[])
+{
+	Parameters par;
+
+	for (int i {1}; i < argc; i++) {
+		string arg {argv[i]};
+		unsigned long pos {arg.find('=')};
+
+		if (pos == string::npos)
+			throw runtime_error("parse(): "+arg);
+
+		string key {arg.substr(0, pos)};
+		string value {arg.substr(pos+1)};
+
+		if (key == "type")
+			par.type = value;
+		else if (key == "pipes")
+			par.pipes = stoi(value);
+		else if (key == "loops")
+			par.loops = stod(value);
+		else if (key == "length") {
+			unsigned long colon {value.find(':')};
+			if (colon == string::npos)
+				throw runtime_error("parse(): length");
+			par.lengthMin = stod(value.substr(0, colon));
+			par.lengthMax = stod(value.substr(colon+1));
+		}
+		else if (key == "lengthdist")
+			par.lengthDist = value;
+		else if (key == "reservoirs")
+			par.reservoirs = stoi(value);
+		else if (key == "demands")
+			par.demands = stod(value);
+		else if (key == "discharge")
+			par.discharge = stod(value);
+		else if (key == "valves")
+			par.valves = stoi(value);
+		else if (key == "diameter")
+			par.diameter = stod(value);
+		else if (key == "symtime")
+			par.symTime = stod(value);
+		else if (key == "discretization")
+			par.discretization = stoi(value);
+		else if (key == "seed")
+			par.seed = stoull(value);
+		else if (key == "dir")
+			par.dir = value;
+		else
+			throw runtime_error("parse(): "+key);
+	}
+
+	// validate
+	if (par.pipes < 1)
+		throw runtime_error("parse(): pipes");
+	else if (par.loops < 0 || par.loops > 1)
+		throw runtime_error("parse(): loops");
+	else if (par.lengthMin <= 0 || par.lengthMax < par.lengthMin)
+		throw runtime_error("parse(): length");
+	else if (par.lengthDist != "uniform" && par.lengthDist != "loguniform")
+		throw runtime_error("parse(): lengthdist");
+	else if (par.reservoirs < 1)
+		throw runtime_error("parse(): reservoirs");
+	else if (par.demands < 0 || par.demands > 1 || par.discharge <= 0)
+		throw runtime_error("parse(): demands");
+	else if (par.valves < 1 || par.diameter <= 0 || par.symTime <= 0)
+		throw runtime_error("parse(): valves/diameter/symtime");
+	else if (par.discretization < 1)
+		throw runtime_error("parse(): discretization");
+
+	return par;
+}
+
+void grid(const Parameters& par, Random& rnd, Graph& g)
+	// n x n nodes, a comb of all horizontal pipes and the
+	//  first column is the spanning tree, remaining vertical
+	//  pipes close loops
+	//
+	// pipes = n^2 - 1 + loops * (n-1)^2
+{
+	int n {2};
+
+	while (n*n - 1 + par.loops * (n-1) * (n-1) < par.pipes) {
+		n++;
+	}
+
+	g.nodeQty = n*n;
+	auto id = [n](const int& r, const int& c) { return r*n + c + 1; };
+
+	for (int r {0}; r < n; r++) {
+		for (int c {0}; c < n; c++) {
+			// horizontal
+			if (c+1 < n)
+				g.pipes.push_back({id(r, c), id(r, c+1)});
+			// vertical
+			if (r+1 < n && (c == 0 || rnd.uniform() < par.loops))
+				g.pipes.push_back({id(r, c), id(r+1, c)});
+		}
+	}
+}
+
+void geometric(const Parameters& par, Random& rnd, Graph& g)
+	// nodes at random points, each joined to its nearest
+	//  predecessor (spanning tree), then to further
+	//  points within the connection radius with
+	//  probability loops
+{
+	// about 1 + loops pipes per node
+	int n {max(2, int(par.pipes / (1 + par.loops)))};
+	double radius {sqrt(4.0 / (acos(-1) * n))};
+		// about 4 neighbours within radius
+	int cells {max(1, int(1 / radius))};
+
+	vector<pair<double, double>> p (n);
+	vector<vector<int>> bucket (cells * cells);
+
+	auto cell = [cells](const double& x) {
+		return min(cells-1, int(x * cells));
+	};
+	auto dist = [&p](const int& i, const int& j) {
+		return hypot(p[i].first - p[j].first, p[i].second - p[j].second);
+	};
+
+	g.nodeQty = n;
+
+	for (int i {0}; i < n; i++) {
+		p[i] = {rnd.uniform(), rnd.uniform()};
+		int cx {cell(p[i].first)};
+		int cy {cell(p[i].second)};
+
+		// nearest predecessor in growing rings of cells
+		int best {-1};
+		double bestDist {1e300};
+
+		for (int ring {0}; i > 0 && ring < cells; ring++) {
+			for (int x {cx-ring}; x <= cx+ring; x++) {
+				for (int y {cy-ring}; y <= cy+ring; y++) {
+					if (x < 0 || y < 0 || x >= cells || y >= cells)
+						continue;
+					if (max(abs(x-cx), abs(y-cy)) != ring)
+						continue;
+					for (int j : bucket[x*cells + y]) {
+						if (dist(i, j) < bestDist) {
+							bestDist = dist(i, j);
+							best = j;
+						}
+					}
+				}
+			}
+			// a closer point cannot lie beyond the next ring
+			if (best >= 0 && bestDist < ring / double(cells))
+				break;
+		}
+
+		if (best >= 0)
+			g.pipes.push_back({best+1, i+1});
+
+		// loop closing pipes to other predecessors
+		for (int x {max(0, cx-1)}; x <= min(cells-1, cx+1); x++) {
+			for (int y {max(0, cy-1)}; y <= min(cells-1, cy+1); y++) {
+				for (int j : bucket[x*cells + y]) {
+					if (j != best && dist(i, j) < radius
+					 && rnd.uniform() < par.loops)
+						g.pipes.push_back({j+1, i+1});
+				}
+			}
+		}
+
+		bucket[cx*cells + cy].push_back(i);
+	}
+}
+
+void tree(const Parameters& par, Random& rnd, Graph& g)
+	// random recursive tree, each node joins a random
+	//  predecessor among the most recent ones so
+	//  branches grow deep
+{
+	int window {max(1, int(sqrt(par.pipes)))};
+
+	g.nodeQty = par.pipes + 1;
+
+	for (int i {2}; i <= g.nodeQty; i++) {
+		int low {max(1, i - window)};
+		g.pipes.push_back({low + rnd.index(i - low), i});
+	}
+}
+
+void line(const Parameters& par, Random& rnd, Graph& g)
+	// chain of pipes, every n-th interior node is a valve
+{
+	g.nodeQty = par.pipes + 1;
+
+	for (int i {1}; i <= par.pipes; i++) {
+		g.pipes.push_back({i, i+1});
+
+		if (i % par.valves == 0 && i+1 < g.nodeQty)
+			g.valves.push_back(i+1);
+	}
+}
+
+void attach(const Parameters& par, Random& rnd, Graph& g)
+{
+	int core {g.nodeQty};
+	vector<bool> taken (core+1, false);
+
+	// valves keep two pipes
+	for (int v : g.valves) {
+		taken[v] = true;
+	}
+
+	// reservoirs spread over core nodes, line ends first
+	for (int i {0}; i < par.reservoirs; i++) {
+		int at {1 + int(double(i) * (core-1) / max(1, par.reservoirs-1))};
+		if (par.reservoirs == 1)
+			at = 1;
+
+		// next free node
+		while (taken[at]) {
+			at = at % core + 1;
+		}
+		taken[at] = true;
+
+		g.pipes.push_back({at, ++g.nodeQty});
+		g.reservoirs.push_back(g.nodeQty);
+	}
+
+	// demands at random free core nodes
+	for (int i {1}; i <= core; i++) {
+		if (!taken[i] && rnd.uniform() < par.demands) {
+			g.pipes.push_back({i, ++g.nodeQty});
+			g.demands.push_back(g.nodeQty);
+		}
+	}
+
+	// the steady state needs two sources
+	if (g.reservoirs.size() + g.demands.size() < 2)
+		throw runtime_error("attach(): at least two reservoirs or demands");
+}
+
+double pipeLength(const Parameters& par, Random& rnd)
+{
+	double u {rnd.uniform()};
+
+	if (par.lengthDist == "loguniform")
+		return par.lengthMin * pow(par.lengthMax / par.lengthMin, u);
+
+	return par.lengthMin + u * (par.lengthMax - par.lengthMin);
+}
+
+void writeElements(const Parameters& par, Random& rnd, const Graph& g)
+{
+	ofstream ofs {par.dir+"/elements"};
+	if (!ofs)
+		throw runtime_error("writeElements(): "+par.dir+"/elements");
+
+	ofs << "// Generated " << par.type << " network - element file\n\n"
+		<< "nodeQty:\t" << g.nodeQty << ";\n"
+		<< "elementQty:\t" << g.pipes.size() << ";\n\n{\n"
+		<< setprecision(6);
+
+	for (unsigned i {0}; i < g.pipes.size(); i++) {
+		ofs << "\t{\n"
+			<< "\tid:\t\t\t" << i+1 << ";\n"
+			<< "\tstart:\t\t" << g.pipes[i].first << ";\n"
+			<< "\tend:\t\t" << g.pipes[i].second << ";\n"
+			<< "\tdiameter:\t" << par.diameter << ";\n"
+			<< "\tlength:\t\t" << pipeLength(par, rnd) << ";\n"
+			<< "\tthickness:\t" << par.diameter / 20 << ";\n"
+			<< "\troughness:\t1.5e-6;\n"
+			<< "\tmaterial:\tsteel;\n"
+			<< "\t}\n";
+	}
+	ofs << "}\n";
+}
+
+void writeNodes(const Parameters& par, Random& rnd, const Graph& g)
+{
+	ofstream ofs {par.dir+"/nodes"};
+	if (!ofs)
+		throw runtime_error("writeNodes(): "+par.dir+"/nodes");
+
+	ofs << "// Generated " << par.type << " network - node file\n"
+		<< setprecision(6);
+
+	// levels differ so that reservoirs exchange water
+	ofs << "\nReservoir\n{\n";
+	for (int r : g.reservoirs) {
+		ofs << "\t{\n"
+			<< "\tid:\t\t\t" << r << ";\n"
+			<< "\tpressure:\t1e5;\n"
+			<< "\tlevel:\t\t" << 20 + 10 * rnd.uniform() << ";\n"
+			<< "\t}\n";
+	}
+	ofs << "}\n";
+
+	if (!g.demands.empty()) {
+		ofs << "\nSource\n{\n";
+		for (int d : g.demands) {
+			ofs << "\t{\n"
+				<< "\tid:\t\t\t" << d << ";\n"
+				<< "\tdischarge:\t" << -par.discharge << ";\n"
+				<< "\t}\n";
+		}
+		ofs << "}\n";
+	}
+
+	// valves close during the second half of the run
+	if (!g.valves.empty()) {
+		ofs << "\nValve\n{\n";
+		for (int v : g.valves) {
+			ofs << "\t{\n"
+				<< "\tid:\t\t\t" << v << ";\n"
+				<< "\tloss:\t\t10;\n"
+				<< "\teventStart:\t" << par.symTime / 2 << ";\n"
+				<< "\teventEnd:\t" << par.symTime * 0.6 << ";\n"
+				<< "\t}\n";
+		}
+		ofs << "}\n";
+	}
+}
+
+void writeSettings(const Parameters& par)
+{
+	ofstream ofs {par.dir+"/settings"};
+	if (!ofs)
+		throw runtime_error("writeSettings(): "+par.dir+"/settings");
+
+	ofs << "// Generated " << par.type << " network - general\n\n"
+		<< "{\n"
+		<< "\tfluid:\t\t\t\twater;\n"
+		<< "\tdiscretization:\t\t" << par.discretization << ";\n"
+		<< "\tsymTime:\t\t\t" << par.symTime << ";\n"
+		<< "}\n";
+}